@@ -17,7 +17,7 @@ OBJS += \
 CMSIS/%.o: ../CMSIS/%.c CMSIS/subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: MCU C Compiler'
-	arm-none-eabi-gcc -D__REDLIB__ -DARM_MATH_CM0PLUS -DCPU_MKL25Z128VLK4 -DCPU_MKL25Z128VLK4_cm0plus -DSDK_OS_BAREMETAL -DFSL_RTOS_BM -DSDK_DEBUGCONSOLE=0 -DCR_INTEGER_PRINTF -DPRINTF_FLOAT_ENABLE=0 -D__MCUXPRESSO -D__USE_CMSIS -DDEBUG -I"/Users/ip/MCUX/ECEN5813_FinalProject/board" -I"/Users/ip/MCUX/ECEN5813_FinalProject/source" -I"/Users/ip/MCUX/ECEN5813_FinalProject" -I"/Users/ip/MCUX/ECEN5813_FinalProject/drivers" -I"/Users/ip/MCUX/ECEN5813_FinalProject/CMSIS" -I"/Users/ip/MCUX/ECEN5813_FinalProject/utilities" -I"/Users/ip/MCUX/ECEN5813_FinalProject/startup" -O0 -fno-common -g3 -Wall -c -fmessage-length=0 -fno-builtin -ffunction-sections -fdata-sections -fmerge-constants -fmacro-prefix-map="$(<D)/"= -mcpu=cortex-m0plus -mthumb -D__REDLIB__ -fstack-usage -specs=redlib.specs -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.o)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
+	arm-none-eabi-gcc -D__REDLIB__ -DARM_MATH_CM0PLUS -DCPU_MKL25Z128VLK4 -DCPU_MKL25Z128VLK4_cm0plus -DSDK_OS_BAREMETAL -DFSL_RTOS_BM -DSDK_DEBUGCONSOLE=0 -DSDK_DEBUGCONSOLE_UART -DCR_INTEGER_PRINTF -DPRINTF_FLOAT_ENABLE=0 -D__MCUXPRESSO -D__USE_CMSIS -DDEBUG -I"/Users/ip/MCUX/ECEN5813_FinalProject/board" -I"/Users/ip/MCUX/ECEN5813_FinalProject/source" -I"/Users/ip/MCUX/ECEN5813_FinalProject" -I"/Users/ip/MCUX/ECEN5813_FinalProject/drivers" -I"/Users/ip/MCUX/ECEN5813_FinalProject/CMSIS" -I"/Users/ip/MCUX/ECEN5813_FinalProject/utilities" -I"/Users/ip/MCUX/ECEN5813_FinalProject/startup" -O0 -fno-common -g3 -Wall -c -fmessage-length=0 -fno-builtin -ffunction-sections -fdata-sections -fmerge-constants -fmacro-prefix-map="$(<D)/"= -mcpu=cortex-m0plus -mthumb -D__REDLIB__ -fstack-usage -specs=redlib.specs -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.o)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -9,6 +9,7 @@ C_SRCS += \
 ../drivers/fsl_flash.c \
 ../drivers/fsl_gpio.c \
 ../drivers/fsl_lpsci.c \
+../drivers/fsl_lpsci_dma.c \
 ../drivers/fsl_smc.c \
 ../drivers/fsl_uart.c 
 
@@ -18,6 +19,7 @@ C_DEPS += \
 ./drivers/fsl_flash.d \
 ./drivers/fsl_gpio.d \
 ./drivers/fsl_lpsci.d \
+./drivers/fsl_lpsci_dma.d \
 ./drivers/fsl_smc.d \
 ./drivers/fsl_uart.d 
 
@@ -27,6 +29,7 @@ OBJS += \
 ./drivers/fsl_flash.o \
 ./drivers/fsl_gpio.o \
 ./drivers/fsl_lpsci.o \
+./drivers/fsl_lpsci_dma.o \
 ./drivers/fsl_smc.o \
 ./drivers/fsl_uart.o 
 
@@ -35,7 +38,7 @@ OBJS += \
 drivers/%.o: ../drivers/%.c drivers/subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: MCU C Compiler'
-	arm-none-eabi-gcc -D__REDLIB__ -DARM_MATH_CM0PLUS -DCPU_MKL25Z128VLK4 -DCPU_MKL25Z128VLK4_cm0plus -DSDK_OS_BAREMETAL -DFSL_RTOS_BM -DSDK_DEBUGCONSOLE=0 -DCR_INTEGER_PRINTF -DPRINTF_FLOAT_ENABLE=0 -D__MCUXPRESSO -D__USE_CMSIS -DDEBUG -I"/Users/ip/MCUX/ECEN5813_FinalProject/board" -I"/Users/ip/MCUX/ECEN5813_FinalProject/source" -I"/Users/ip/MCUX/ECEN5813_FinalProject" -I"/Users/ip/MCUX/ECEN5813_FinalProject/drivers" -I"/Users/ip/MCUX/ECEN5813_FinalProject/CMSIS" -I"/Users/ip/MCUX/ECEN5813_FinalProject/utilities" -I"/Users/ip/MCUX/ECEN5813_FinalProject/startup" -O0 -fno-common -g3 -Wall -c -fmessage-length=0 -fno-builtin -ffunction-sections -fdata-sections -fmerge-constants -fmacro-prefix-map="$(<D)/"= -mcpu=cortex-m0plus -mthumb -D__REDLIB__ -fstack-usage -specs=redlib.specs -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.o)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
+	arm-none-eabi-gcc -D__REDLIB__ -DARM_MATH_CM0PLUS -DCPU_MKL25Z128VLK4 -DCPU_MKL25Z128VLK4_cm0plus -DSDK_OS_BAREMETAL -DFSL_RTOS_BM -DSDK_DEBUGCONSOLE=0 -DSDK_DEBUGCONSOLE_UART -DCR_INTEGER_PRINTF -DPRINTF_FLOAT_ENABLE=0 -D__MCUXPRESSO -D__USE_CMSIS -DDEBUG -I"/Users/ip/MCUX/ECEN5813_FinalProject/board" -I"/Users/ip/MCUX/ECEN5813_FinalProject/source" -I"/Users/ip/MCUX/ECEN5813_FinalProject" -I"/Users/ip/MCUX/ECEN5813_FinalProject/drivers" -I"/Users/ip/MCUX/ECEN5813_FinalProject/CMSIS" -I"/Users/ip/MCUX/ECEN5813_FinalProject/utilities" -I"/Users/ip/MCUX/ECEN5813_FinalProject/startup" -O0 -fno-common -g3 -Wall -c -fmessage-length=0 -fno-builtin -ffunction-sections -fdata-sections -fmerge-constants -fmacro-prefix-map="$(<D)/"= -mcpu=cortex-m0plus -mthumb -D__REDLIB__ -fstack-usage -specs=redlib.specs -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.o)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -43,7 +46,7 @@ drivers/%.o: ../drivers/%.c drivers/subdir.mk
 clean: clean-drivers
 
 clean-drivers:
-	-$(RM) ./drivers/fsl_clock.d ./drivers/fsl_clock.o ./drivers/fsl_common.d ./drivers/fsl_common.o ./drivers/fsl_flash.d ./drivers/fsl_flash.o ./drivers/fsl_gpio.d ./drivers/fsl_gpio.o ./drivers/fsl_lpsci.d ./drivers/fsl_lpsci.o ./drivers/fsl_smc.d ./drivers/fsl_smc.o ./drivers/fsl_uart.d ./drivers/fsl_uart.o
+	-$(RM) ./drivers/fsl_clock.d ./drivers/fsl_clock.o ./drivers/fsl_common.d ./drivers/fsl_common.o ./drivers/fsl_flash.d ./drivers/fsl_flash.o ./drivers/fsl_gpio.d ./drivers/fsl_gpio.o ./drivers/fsl_lpsci.d ./drivers/fsl_lpsci.o ./drivers/fsl_lpsci_dma.d ./drivers/fsl_lpsci_dma.o ./drivers/fsl_smc.d ./drivers/fsl_smc.o ./drivers/fsl_uart.d ./drivers/fsl_uart.o
 
 .PHONY: clean-drivers
 
@@ -4,44 +4,104 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../source/adc_cal.c \
+../source/adc_decimate.c \
 ../source/analog_peripherals.c \
+../source/app_config.c \
+../source/boot_profile.c \
+../source/capture_log.c \
+../source/cpu_cycles.c \
+../source/crc16.c \
+../source/dsp_bench.c \
 ../source/dsp_fft.c \
+../source/dsp_selftest.c \
+../source/flash_store.c \
 ../source/leds.c \
 ../source/main.c \
+../source/mem_usage.c \
 ../source/mtb.c \
+../source/mtb_trace.c \
+../source/note_tracker.c \
+../source/sample_codec.c \
+../source/scheduler.c \
 ../source/semihost_hardfault.c \
+../source/shell.c \
+../source/standby.c \
+../source/telemetry.c \
 ../source/test_dsp_fft.c \
+../source/tlog.c \
 ../source/touch_sensor.c \
-../source/tpm_sync.c 
+../source/tpm_sync.c \
+../source/tuner.c 
 
 C_DEPS += \
+./source/adc_cal.d \
+./source/adc_decimate.d \
 ./source/analog_peripherals.d \
+./source/app_config.d \
+./source/boot_profile.d \
+./source/capture_log.d \
+./source/cpu_cycles.d \
+./source/crc16.d \
+./source/dsp_bench.d \
 ./source/dsp_fft.d \
+./source/dsp_selftest.d \
+./source/flash_store.d \
 ./source/leds.d \
 ./source/main.d \
+./source/mem_usage.d \
 ./source/mtb.d \
+./source/mtb_trace.d \
+./source/note_tracker.d \
+./source/sample_codec.d \
+./source/scheduler.d \
 ./source/semihost_hardfault.d \
+./source/shell.d \
+./source/standby.d \
+./source/telemetry.d \
 ./source/test_dsp_fft.d \
+./source/tlog.d \
 ./source/touch_sensor.d \
-./source/tpm_sync.d 
+./source/tpm_sync.d \
+./source/tuner.d 
 
 OBJS += \
+./source/adc_cal.o \
+./source/adc_decimate.o \
 ./source/analog_peripherals.o \
+./source/app_config.o \
+./source/boot_profile.o \
+./source/capture_log.o \
+./source/cpu_cycles.o \
+./source/crc16.o \
+./source/dsp_bench.o \
 ./source/dsp_fft.o \
+./source/dsp_selftest.o \
+./source/flash_store.o \
 ./source/leds.o \
 ./source/main.o \
+./source/mem_usage.o \
 ./source/mtb.o \
+./source/mtb_trace.o \
+./source/note_tracker.o \
+./source/sample_codec.o \
+./source/scheduler.o \
 ./source/semihost_hardfault.o \
+./source/shell.o \
+./source/standby.o \
+./source/telemetry.o \
 ./source/test_dsp_fft.o \
+./source/tlog.o \
 ./source/touch_sensor.o \
-./source/tpm_sync.o 
+./source/tpm_sync.o \
+./source/tuner.o 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 source/%.o: ../source/%.c source/subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: MCU C Compiler'
-	arm-none-eabi-gcc -D__REDLIB__ -DARM_MATH_CM0PLUS -DCPU_MKL25Z128VLK4 -DCPU_MKL25Z128VLK4_cm0plus -DSDK_OS_BAREMETAL -DFSL_RTOS_BM -DSDK_DEBUGCONSOLE=0 -DCR_INTEGER_PRINTF -DPRINTF_FLOAT_ENABLE=0 -D__MCUXPRESSO -D__USE_CMSIS -DDEBUG -I"/Users/ip/MCUX/ECEN5813_FinalProject/board" -I"/Users/ip/MCUX/ECEN5813_FinalProject/source" -I"/Users/ip/MCUX/ECEN5813_FinalProject" -I"/Users/ip/MCUX/ECEN5813_FinalProject/drivers" -I"/Users/ip/MCUX/ECEN5813_FinalProject/CMSIS" -I"/Users/ip/MCUX/ECEN5813_FinalProject/utilities" -I"/Users/ip/MCUX/ECEN5813_FinalProject/startup" -O0 -fno-common -g3 -Wall -c -fmessage-length=0 -fno-builtin -ffunction-sections -fdata-sections -fmerge-constants -fmacro-prefix-map="$(<D)/"= -mcpu=cortex-m0plus -mthumb -D__REDLIB__ -fstack-usage -specs=redlib.specs -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.o)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
+	arm-none-eabi-gcc -D__REDLIB__ -DARM_MATH_CM0PLUS -DCPU_MKL25Z128VLK4 -DCPU_MKL25Z128VLK4_cm0plus -DSDK_OS_BAREMETAL -DFSL_RTOS_BM -DSDK_DEBUGCONSOLE=0 -DSDK_DEBUGCONSOLE_UART -DCR_INTEGER_PRINTF -DPRINTF_FLOAT_ENABLE=0 -D__MCUXPRESSO -D__USE_CMSIS -DDEBUG -I"/Users/ip/MCUX/ECEN5813_FinalProject/board" -I"/Users/ip/MCUX/ECEN5813_FinalProject/source" -I"/Users/ip/MCUX/ECEN5813_FinalProject" -I"/Users/ip/MCUX/ECEN5813_FinalProject/drivers" -I"/Users/ip/MCUX/ECEN5813_FinalProject/CMSIS" -I"/Users/ip/MCUX/ECEN5813_FinalProject/utilities" -I"/Users/ip/MCUX/ECEN5813_FinalProject/startup" -O0 -fno-common -g3 -Wall -c -fmessage-length=0 -fno-builtin -ffunction-sections -fdata-sections -fmerge-constants -fmacro-prefix-map="$(<D)/"= -mcpu=cortex-m0plus -mthumb -D__REDLIB__ -fstack-usage -specs=redlib.specs -MMD -MP -MF"$(@:%.o=%.d)" -MT"$(@:%.o=%.o)" -MT"$(@:%.o=%.d)" -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -49,7 +109,7 @@ source/%.o: ../source/%.c source/subdir.mk
 clean: clean-source
 
 clean-source:
-	-$(RM) ./source/analog_peripherals.d ./source/analog_peripherals.o ./source/dsp_fft.d ./source/dsp_fft.o ./source/leds.d ./source/leds.o ./source/main.d ./source/main.o ./source/mtb.d ./source/mtb.o ./source/semihost_hardfault.d ./source/semihost_hardfault.o ./source/test_dsp_fft.d ./source/test_dsp_fft.o ./source/touch_sensor.d ./source/touch_sensor.o ./source/tpm_sync.d ./source/tpm_sync.o
+	-$(RM) ./source/adc_cal.d ./source/adc_cal.o ./source/adc_decimate.d ./source/adc_decimate.o ./source/analog_peripherals.d ./source/analog_peripherals.o ./source/app_config.d ./source/app_config.o ./source/boot_profile.d ./source/boot_profile.o ./source/capture_log.d ./source/capture_log.o ./source/cpu_cycles.d ./source/cpu_cycles.o ./source/crc16.d ./source/crc16.o ./source/dsp_bench.d ./source/dsp_bench.o ./source/dsp_fft.d ./source/dsp_fft.o ./source/dsp_selftest.d ./source/dsp_selftest.o ./source/flash_store.d ./source/flash_store.o ./source/leds.d ./source/leds.o ./source/main.d ./source/main.o ./source/mem_usage.d ./source/mem_usage.o ./source/mtb.d ./source/mtb.o ./source/mtb_trace.d ./source/mtb_trace.o ./source/note_tracker.d ./source/note_tracker.o ./source/sample_codec.d ./source/sample_codec.o ./source/scheduler.d ./source/scheduler.o ./source/semihost_hardfault.d ./source/semihost_hardfault.o ./source/shell.d ./source/shell.o ./source/standby.d ./source/standby.o ./source/telemetry.d ./source/telemetry.o ./source/test_dsp_fft.d ./source/test_dsp_fft.o ./source/tlog.d ./source/tlog.o ./source/touch_sensor.d ./source/touch_sensor.o ./source/tpm_sync.d ./source/tpm_sync.o ./source/tuner.d ./source/tuner.o
 
 .PHONY: clean-source
 
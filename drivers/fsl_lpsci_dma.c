@@ -0,0 +1,190 @@
+/*
+ * @file fsl_lpsci_dma.c
+ *
+ * @brief	LPSCI (UART0) transmit over a DMA channel, see fsl_lpsci_dma.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include "fsl_lpsci_dma.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief DMAMUX source of the LPSCI0 transmit request. */
+#define LPSCI_DMA_TX_SOURCE ((uint32_t)kDmaRequestMux0LPSCI0Tx & 0xFFU)
+
+/*! @brief LPSCI transfer state, matches the transactional driver. */
+enum _lpsci_dma_transfer_states
+{
+    kLPSCI_TxIdle, /* TX idle. */
+    kLPSCI_TxBusy, /* TX busy. */
+};
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! @brief Handle attached to each DMA channel, for the channel interrupts. */
+static lpsci_dma_handle_t *s_lpsciDmaHandle[LPSCI_DMA_CHANNEL_COUNT];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void LPSCI_TransferTxCreateHandleDMA(UART0_Type *base,
+                                     lpsci_dma_handle_t *handle,
+                                     lpsci_dma_transfer_callback_t callback,
+                                     void *userData,
+                                     uint32_t txDmaChannel)
+{
+    assert(handle);
+    assert((txDmaChannel > 0U) && (txDmaChannel < LPSCI_DMA_CHANNEL_COUNT));
+
+    memset(handle, 0, sizeof(*handle));
+    handle->base = base;
+    handle->callback = callback;
+    handle->userData = userData;
+    handle->txDmaChannel = txDmaChannel;
+    handle->txState = kLPSCI_TxIdle;
+
+    s_lpsciDmaHandle[txDmaChannel] = handle;
+
+    /* Clock gating for the DMA controller and the request mux. */
+    SIM->SCGC7 |= SIM_SCGC7_DMA_MASK;
+    SIM->SCGC6 |= SIM_SCGC6_DMAMUX_MASK;
+
+    /* The mux must be disabled while the source changes. */
+    DMAMUX0->CHCFG[txDmaChannel] = 0U;
+    DMAMUX0->CHCFG[txDmaChannel] = DMAMUX_CHCFG_SOURCE(LPSCI_DMA_TX_SOURCE) | DMAMUX_CHCFG_ENBL_MASK;
+
+    NVIC_ClearPendingIRQ((IRQn_Type)(DMA0_IRQn + txDmaChannel));
+    EnableIRQ((IRQn_Type)(DMA0_IRQn + txDmaChannel));
+}
+
+status_t LPSCI_TransferSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t *xfer)
+{
+    assert(handle);
+
+    DMA_Type *dma = DMA0;
+    uint32_t ch = handle->txDmaChannel;
+
+    /* Return error if xfer invalid. */
+    if ((0U == xfer->dataSize) || (NULL == xfer->data) || (xfer->dataSize > DMA_DSR_BCR_BCR_MASK))
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    /* If previous TX not finished. */
+    if (kLPSCI_TxBusy == handle->txState)
+    {
+        return kStatus_LPSCI_TxBusy;
+    }
+
+    handle->txState = kLPSCI_TxBusy;
+    handle->txDataSizeAll = xfer->dataSize;
+
+    /* Clear DONE and any error left from the last transfer, then load the new one. */
+    dma->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    dma->DMA[ch].SAR = (uint32_t)xfer->data;
+    dma->DMA[ch].DAR = LPSCI_GetDataRegisterAddress(base);
+    dma->DMA[ch].DSR_BCR = DMA_DSR_BCR_BCR(xfer->dataSize);
+
+    /* One byte per request, source increments, request cleared when BCR reaches 0. */
+    dma->DMA[ch].DCR = DMA_DCR_EINT_MASK | DMA_DCR_ERQ_MASK | DMA_DCR_CS_MASK | DMA_DCR_SINC_MASK |
+                       DMA_DCR_SSIZE(1U) | DMA_DCR_DSIZE(1U) | DMA_DCR_D_REQ_MASK;
+
+    /* TDRE now raises a DMA request instead of an interrupt. */
+    LPSCI_EnableTxDMA(base, true);
+
+    return kStatus_Success;
+}
+
+void LPSCI_TransferAbortSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle)
+{
+    assert(handle);
+
+    DMA_Type *dma = DMA0;
+    uint32_t ch = handle->txDmaChannel;
+
+    /* Disable LPSCI TX DMA. */
+    LPSCI_EnableTxDMA(base, false);
+
+    /* Stop the channel. */
+    dma->DMA[ch].DCR &= ~DMA_DCR_ERQ_MASK;
+    dma->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    handle->txState = kLPSCI_TxIdle;
+}
+
+status_t LPSCI_TransferGetSendCountDMA(UART0_Type *base, lpsci_dma_handle_t *handle, uint32_t *count)
+{
+    assert(handle);
+
+    if (!count)
+    {
+        return kStatus_InvalidArgument;
+    }
+
+    if (kLPSCI_TxIdle == handle->txState)
+    {
+        return kStatus_NoTransferInProgress;
+    }
+
+    *count = handle->txDataSizeAll - (DMA0->DMA[handle->txDmaChannel].DSR_BCR & DMA_DSR_BCR_BCR_MASK);
+
+    return kStatus_Success;
+}
+
+void LPSCI_TransferDMAHandleIRQ(lpsci_dma_handle_t *handle)
+{
+    DMA_Type *dma = DMA0;
+    uint32_t ch = handle->txDmaChannel;
+    uint32_t dsr = dma->DMA[ch].DSR_BCR;
+    status_t status = kStatus_LPSCI_TxIdle;
+
+    /* A configuration or bus error also sets DONE, report it instead of idle. */
+    if (dsr & (DMA_DSR_BCR_CE_MASK | DMA_DSR_BCR_BES_MASK | DMA_DSR_BCR_BED_MASK))
+    {
+        status = kStatus_Fail;
+    }
+    dma->DMA[ch].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+
+    /* Disable LPSCI TX DMA. */
+    LPSCI_EnableTxDMA(handle->base, false);
+
+    handle->txState = kLPSCI_TxIdle;
+
+    if (handle->callback)
+    {
+        handle->callback(handle->base, handle, status, handle->userData);
+    }
+}
+
+/* Channel 0 is the ADC's, its DMA0_IRQHandler lives in analog_peripherals.c. */
+void DMA1_DriverIRQHandler(void)
+{
+    if (s_lpsciDmaHandle[1])
+    {
+        LPSCI_TransferDMAHandleIRQ(s_lpsciDmaHandle[1]);
+    }
+}
+
+void DMA2_DriverIRQHandler(void)
+{
+    if (s_lpsciDmaHandle[2])
+    {
+        LPSCI_TransferDMAHandleIRQ(s_lpsciDmaHandle[2]);
+    }
+}
+
+void DMA3_DriverIRQHandler(void)
+{
+    if (s_lpsciDmaHandle[3])
+    {
+        LPSCI_TransferDMAHandleIRQ(s_lpsciDmaHandle[3]);
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * @file fsl_lpsci_dma.h
+ *
+ * @brief	LPSCI (UART0) transmit over a DMA channel, laid out like the SDK's
+ * 			fsl_lpsci_dma driver
+ *
+ * The SDK driver sits on fsl_dma/fsl_dmamux, which this project does not
+ * carry, so this one programs the DMA channel registers directly and takes a
+ * channel number where the SDK takes a dma_handle_t. Channel 0 belongs to the
+ * ADC ping-pong (analog_peripherals.c), use 1 to 3.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+#ifndef _FSL_LPSCI_DMA_H_
+#define _FSL_LPSCI_DMA_H_
+
+#include "fsl_lpsci.h"
+
+/*!
+ * @addtogroup lpsci_dma_driver
+ * @{
+ */
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! @brief DMA channels the handle table covers. */
+#define LPSCI_DMA_CHANNEL_COUNT (4U)
+
+/* Forward declaration of the handle typedef. */
+typedef struct _lpsci_dma_handle lpsci_dma_handle_t;
+
+/*! @brief LPSCI transfer callback function. */
+typedef void (*lpsci_dma_transfer_callback_t)(UART0_Type *base,
+                                              lpsci_dma_handle_t *handle,
+                                              status_t status,
+                                              void *userData);
+
+/*!
+ * @brief LPSCI DMA handle
+ */
+struct _lpsci_dma_handle
+{
+    UART0_Type *base;                       /*!< LPSCI peripheral base address. */
+    lpsci_dma_transfer_callback_t callback; /*!< Callback function. */
+    void *userData;                         /*!< Callback function parameter.*/
+    size_t txDataSizeAll;                   /*!< Size of the data to send out. */
+    uint8_t txDmaChannel;                   /*!< DMA channel used to send. */
+    volatile uint8_t txState;               /*!< TX transfer state. */
+};
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* _cplusplus */
+
+/*!
+ * @name DMA transactional
+ * @{
+ */
+
+/*!
+ * @brief Initializes the LPSCI handle used for DMA transmit.
+ *
+ * Routes the LPSCI0 TX request through DMAMUX to the channel and enables the channel interrupt.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle Pointer to lpsci_dma_handle_t structure.
+ * @param callback Called from the DMA interrupt when a transfer finishes.
+ * @param userData User data passed to the callback.
+ * @param txDmaChannel DMA channel, 1 to 3.
+ */
+void LPSCI_TransferTxCreateHandleDMA(UART0_Type *base,
+                                     lpsci_dma_handle_t *handle,
+                                     lpsci_dma_transfer_callback_t callback,
+                                     void *userData,
+                                     uint32_t txDmaChannel);
+
+/*!
+ * @brief Sends data using DMA.
+ *
+ * Returns at once. The DMA moves one byte per TDRE request and the callback runs with
+ * kStatus_LPSCI_TxIdle once the last byte is in the data register. The buffer must stay
+ * valid until then.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle Pointer to lpsci_dma_handle_t structure.
+ * @param xfer LPSCI DMA transfer structure, see #lpsci_transfer_t.
+ * @retval kStatus_Success if succeeded, others failed.
+ * @retval kStatus_LPSCI_TxBusy Previous transfer on going.
+ * @retval kStatus_InvalidArgument Invalid argument.
+ */
+status_t LPSCI_TransferSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle, lpsci_transfer_t *xfer);
+
+/*!
+ * @brief Aborts the sent data using DMA.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle Pointer to lpsci_dma_handle_t structure.
+ */
+void LPSCI_TransferAbortSendDMA(UART0_Type *base, lpsci_dma_handle_t *handle);
+
+/*!
+ * @brief Gets the number of bytes written to the LPSCI TX register.
+ *
+ * @param base LPSCI peripheral base address.
+ * @param handle LPSCI handle pointer.
+ * @param count Number of bytes sent so far by the non-blocking transaction.
+ * @retval kStatus_NoTransferInProgress transfer has finished or no transfer in progress.
+ * @retval kStatus_InvalidArgument Parameter is invalid.
+ * @retval kStatus_Success Successfully return the count.
+ */
+status_t LPSCI_TransferGetSendCountDMA(UART0_Type *base, lpsci_dma_handle_t *handle, uint32_t *count);
+
+/*!
+ * @brief Channel interrupt handling, called from DMAn_DriverIRQHandler.
+ *
+ * @param handle Pointer to lpsci_dma_handle_t structure.
+ */
+void LPSCI_TransferDMAHandleIRQ(lpsci_dma_handle_t *handle);
+
+/*@}*/
+
+#if defined(__cplusplus)
+}
+#endif
+
+/*! @}*/
+
+#endif /* _FSL_LPSCI_DMA_H_ */
@@ -0,0 +1,249 @@
+/*
+ * @file adc_cal.c
+ *
+ * @brief	Stored ADC0 calibration, see adc_cal.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "MKL25Z4.h"
+#include <cpu_cycles.h>
+#include <crc16.h>
+#include <flash_store.h>
+#include <adc_cal.h>
+
+#define ADC_CAL_MAGIC       (0x4C414341U)   // "ACAL"
+#define ADC_CAL_HEADER      (12U)
+#define ADC_CH_TEMP         (26U)
+#define ADC_CH_BANDGAP      (27U)
+
+#if (ADC_CAL_ADDR % FLASH_STORE_SECTOR_SIZE)
+#error "ADC_CAL_ADDR must be sector aligned"
+#endif
+// adc_cal_data_t is programmed a word at a time
+typedef char adc_cal_data_whole_words[(sizeof(adc_cal_data_t) % 4) ? -1 : 1];
+
+static adc_cal_status_t status;
+static uint32_t cal_start;              // when the running calibration was started
+static adc_cal_source_t cal_pending;    // ADC_CAL_NONE unless one is running
+
+// one conversion in software trigger mode, the caller picks the averaging
+static uint16_t adc_cal_measure(uint32_t channel) {
+  ADC0->SC1[0] = ADC_SC1_ADCH(channel);
+  while (!(ADC0->SC1[0] & ADC_SC1_COCO_MASK)) {;}
+  return (uint16_t)ADC0->R[0];
+}
+
+// temperature sensor and bandgap with 16 sample averaging
+static void adc_cal_references(uint16_t* temp, uint16_t* bandgap) {
+  uint8_t regsc = PMC->REGSC & ~PMC_REGSC_ACKISO_MASK;
+
+  // the bandgap buffer is off unless asked for
+  PMC->REGSC = regsc | PMC_REGSC_BGBE_MASK;
+  ADC0->SC3 = ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(2);
+  *temp = adc_cal_measure(ADC_CH_TEMP);
+  *bandgap = adc_cal_measure(ADC_CH_BANDGAP);
+  PMC->REGSC = regsc;
+}
+
+// starts the hardware calibration, datasheet sec. 28.4.6
+static void adc_cal_hardware_start() {
+  cal_start = cpu_cycles_now();
+  // turn on averaging (32) for the calibration sequence and start it
+  ADC0->SC3 = ADC_SC3_CAL_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(3);
+}
+
+// waits for the calibration started above and computes the gains
+static bool adc_cal_hardware(adc_cal_data_t* data) {
+  while (!(ADC0->SC1[0] & ADC_SC1_COCO_MASK)) {;} // wait for calibration complete
+  data->cal_cycles = cpu_cycles_since(cal_start);
+  if (ADC0->SC3 & ADC_SC3_CALF_MASK) {
+    return false;
+  }
+
+  // plus-side calibration
+  uint16_t cal = ADC0->CLP0+ADC0->CLP1+ADC0->CLP2+ADC0->CLP3+ADC0->CLP4+ADC0->CLPS;
+  cal = cal/2;
+  cal |= (1<<15); // set MSB
+  ADC0->PG = cal; // write calibration
+
+  // minus-side calibration
+  cal = ADC0->CLM0+ADC0->CLM1+ADC0->CLM2+ADC0->CLM3+ADC0->CLM4+ADC0->CLMS;
+  cal = cal/2;
+  cal |= (1<<15); // set MSB
+  ADC0->MG = cal; // write calibration
+
+  data->ofs = ADC0->OFS;
+  data->pg = ADC0->PG;
+  data->mg = ADC0->MG;
+  data->clpd = ADC0->CLPD;
+  data->clps = ADC0->CLPS;
+  data->clp4 = ADC0->CLP4;
+  data->clp3 = ADC0->CLP3;
+  data->clp2 = ADC0->CLP2;
+  data->clp1 = ADC0->CLP1;
+  data->clp0 = ADC0->CLP0;
+  data->clmd = ADC0->CLMD;
+  data->clms = ADC0->CLMS;
+  data->clm4 = ADC0->CLM4;
+  data->clm3 = ADC0->CLM3;
+  data->clm2 = ADC0->CLM2;
+  data->clm1 = ADC0->CLM1;
+  data->clm0 = ADC0->CLM0;
+  data->reserved = 0;
+  adc_cal_references(&data->temp_ref, &data->bandgap_ref);
+  return true;
+}
+
+// writes a stored calibration back into ADC0
+static void adc_cal_apply(const adc_cal_data_t* data) {
+  ADC0->OFS = data->ofs;
+  ADC0->PG = data->pg;
+  ADC0->MG = data->mg;
+  ADC0->CLPD = data->clpd;
+  ADC0->CLPS = data->clps;
+  ADC0->CLP4 = data->clp4;
+  ADC0->CLP3 = data->clp3;
+  ADC0->CLP2 = data->clp2;
+  ADC0->CLP1 = data->clp1;
+  ADC0->CLP0 = data->clp0;
+  ADC0->CLMD = data->clmd;
+  ADC0->CLMS = data->clms;
+  ADC0->CLM4 = data->clm4;
+  ADC0->CLM3 = data->clm3;
+  ADC0->CLM2 = data->clm2;
+  ADC0->CLM1 = data->clm1;
+  ADC0->CLM0 = data->clm0;
+}
+
+// a copy of the block if its header, version and CRC check out
+static bool adc_cal_load(adc_cal_data_t* data) {
+  uint32_t w1 = flash_store_read_word(ADC_CAL_ADDR + 4);
+  uint32_t w2 = flash_store_read_word(ADC_CAL_ADDR + 8);
+  const adc_cal_data_t* stored = (const adc_cal_data_t*)(ADC_CAL_ADDR + ADC_CAL_HEADER);
+
+  if (flash_store_read_word(ADC_CAL_ADDR) != ADC_CAL_MAGIC ||
+      w1 != (ADC_CAL_VERSION | (sizeof(adc_cal_data_t) << 16)) ||
+      (uint16_t)w2 != (uint16_t)~(w2 >> 16) ||
+      crc16_ccitt(CRC16_INIT, stored, sizeof(adc_cal_data_t)) != (uint16_t)w2) {
+    return false;
+  }
+  *data = *stored;
+  return true;
+}
+
+// erase and program the block, the magic last
+static bool adc_cal_store(const adc_cal_data_t* data) {
+  const uint32_t* words = (const uint32_t*)data;
+  uint16_t crc = crc16_ccitt(CRC16_INIT, data, sizeof(adc_cal_data_t));
+  bool ok = flash_store_init();
+
+  if (ok && !flash_store_is_blank(ADC_CAL_ADDR, FLASH_STORE_SECTOR_SIZE)) {
+    ok = flash_store_erase_sector(ADC_CAL_ADDR);
+  }
+  for (uint32_t i = 0; ok && i < sizeof(adc_cal_data_t) / 4; i++) {
+    ok = flash_store_program_word(ADC_CAL_ADDR + ADC_CAL_HEADER + 4 * i, words[i]);
+  }
+  ok = ok && flash_store_program_word(ADC_CAL_ADDR + 4, ADC_CAL_VERSION | (sizeof(adc_cal_data_t) << 16));
+  ok = ok && flash_store_program_word(ADC_CAL_ADDR + 8, crc | ((uint32_t)(uint16_t)~crc << 16));
+  ok = ok && flash_store_program_word(ADC_CAL_ADDR, ADC_CAL_MAGIC);
+  return ok;
+}
+
+// finish a calibration, store it and record where it came from
+static bool adc_cal_finish(adc_cal_source_t source) {
+  adc_cal_data_t data;
+
+  if (!adc_cal_hardware(&data)) {
+    status.source = ADC_CAL_FAILED;
+    status.stored = false;
+    return false;
+  }
+  status.source = source;
+  status.cal_cycles = data.cal_cycles;
+  status.temp_delta = 0;
+  status.bandgap_delta = 0;
+  status.stored = adc_cal_store(&data);
+  return status.stored;
+}
+
+// see .h for more details
+bool adc_cal_boot_start() {
+  uint32_t start = cpu_cycles_now();
+  adc_cal_data_t data;
+
+  cal_pending = ADC_CAL_NONE;
+  if (!adc_cal_load(&data)) {
+    cal_pending = ADC_CAL_NEW;
+  } else {
+    uint16_t temp, bandgap;
+    adc_cal_apply(&data);
+    adc_cal_references(&temp, &bandgap);
+    status.temp_delta = (int32_t)temp - data.temp_ref;
+    status.bandgap_delta = (int32_t)bandgap - data.bandgap_ref;
+
+    if (status.temp_delta > ADC_CAL_TEMP_DRIFT || status.temp_delta < -ADC_CAL_TEMP_DRIFT ||
+        status.bandgap_delta > ADC_CAL_VDD_DRIFT || status.bandgap_delta < -ADC_CAL_VDD_DRIFT) {
+      cal_pending = ADC_CAL_DRIFT;
+    } else {
+      status.source = ADC_CAL_RESTORED;
+      status.cal_cycles = data.cal_cycles;
+      status.stored = true;
+    }
+  }
+  if (cal_pending != ADC_CAL_NONE) {
+    adc_cal_hardware_start();
+  }
+  status.boot_cycles = cpu_cycles_since(start);
+  return cal_pending != ADC_CAL_NONE;
+}
+
+// see .h for more details
+bool adc_cal_boot_finish() {
+  uint32_t start = cpu_cycles_now();
+  bool ok = true;
+
+  if (cal_pending != ADC_CAL_NONE) {
+    ok = adc_cal_finish(cal_pending);
+    cal_pending = ADC_CAL_NONE;
+  }
+
+  // averaging off again for the DMA driven sampling
+  ADC0->SC3 = 0;
+  status.boot_cycles += cpu_cycles_since(start);
+  return ok;
+}
+
+// see .h for more details
+bool adc_cal_boot() {
+  adc_cal_boot_start();
+  return adc_cal_boot_finish();
+}
+
+// see .h for more details
+bool adc_cal_run() {
+  uint32_t sc1 = ADC0->SC1[0];
+  uint32_t sc2 = ADC0->SC2;
+  uint32_t sc3 = ADC0->SC3;
+
+  // software triggered and no DMA requests while calibrating
+  ADC0->SC2 = sc2 & ~(ADC_SC2_ADTRG_MASK | ADC_SC2_DMAEN_MASK);
+  adc_cal_hardware_start();
+  bool ok = adc_cal_finish(ADC_CAL_REQUESTED);
+
+  // hardware trigger back first, so rewriting SC1 does not start a conversion
+  ADC0->SC3 = sc3 & ~ADC_SC3_CAL_MASK;
+  ADC0->SC2 = sc2;
+  ADC0->SC1[0] = sc1 & ~ADC_SC1_COCO_MASK;
+  return ok;
+}
+
+// see .h for more details
+void adc_cal_get_status(adc_cal_status_t* out) {
+  *out = status;
+}
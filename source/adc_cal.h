@@ -0,0 +1,124 @@
+/*
+ * @file adc_cal.h
+ *
+ * @brief	ADC0 calibration kept in a flash parameter block so a reset does not
+ * 			have to run the hardware calibration again
+ *
+ * The calibration (datasheet sec. 28.4.6, 32 sample averaging) takes a few
+ * milliseconds of busy waiting on COCO. Its results (OFS, PG, MG, CLPD/CLPS/
+ * CLP4..0, CLMD/CLMS/CLM4..0) are stored in the last flash sector, which
+ * capture_log.h leaves free, with the temperature sensor and bandgap readings
+ * taken right after it. At boot adc_cal_boot() writes them back and takes
+ * both readings again. The hardware calibration only runs when there is no
+ * valid block, when either reading has drifted past its limit, or on demand
+ * (`calibrate` in the shell).
+ *
+ * block:  magic "ACAL" (4) | version (2) | data bytes (2) | crc (2) | ~crc (2) | adc_cal_data_t
+ * 	The magic is programmed last, so a block cut short by a reset reads as
+ * 	missing. A different ADC_CAL_VERSION or data size is treated the same way.
+ *
+ * Build options:
+ * 	ADC_CAL_ADDR        flash sector of the block (default 0x1FC00)
+ * 	ADC_CAL_TEMP_DRIFT  temperature sensor counts that force a recalibration (default 320, ~10 C)
+ * 	ADC_CAL_VDD_DRIFT   bandgap counts that force a recalibration (default 600, ~3% of VDD)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _ADC_CAL_H_
+#define _ADC_CAL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef ADC_CAL_ADDR
+#define ADC_CAL_ADDR (0x1FC00U)
+#endif
+
+#ifndef ADC_CAL_TEMP_DRIFT
+#define ADC_CAL_TEMP_DRIFT (320)
+#endif
+
+#ifndef ADC_CAL_VDD_DRIFT
+#define ADC_CAL_VDD_DRIFT (600)
+#endif
+
+#define ADC_CAL_VERSION (1U)
+
+// where the calibration in use came from
+typedef enum {
+  ADC_CAL_NONE      = 0,    // not calibrated yet
+  ADC_CAL_RESTORED  = 1,    // written back from flash
+  ADC_CAL_NEW       = 2,    // no valid block, calibrated and stored
+  ADC_CAL_DRIFT     = 3,    // stored block failed the drift checks, recalibrated
+  ADC_CAL_REQUESTED = 4,    // adc_cal_run() from the shell
+  ADC_CAL_FAILED    = 5     // the hardware reported CALF
+} adc_cal_source_t;
+
+// what is stored in the block
+typedef struct {
+  uint16_t ofs, pg, mg;
+  uint16_t clpd, clps, clp4, clp3, clp2, clp1, clp0;
+  uint16_t clmd, clms, clm4, clm3, clm2, clm1, clm0;
+  uint16_t temp_ref;        // temperature sensor (ADCH 26) right after calibrating
+  uint16_t bandgap_ref;     // bandgap (ADCH 27); VREFH is VDD, so this tracks the supply
+  uint16_t reserved;
+  uint32_t cal_cycles;      // core cycles the hardware calibration took
+} adc_cal_data_t;
+
+typedef struct {
+  adc_cal_source_t source;
+  uint32_t boot_cycles;     // cycles spent in adc_cal_boot_start() and _finish(), restore and checks included
+  uint32_t cal_cycles;      // cycles of the last hardware calibration, from flash if restored
+  int32_t temp_delta;       // reading minus the stored reference at the last check
+  int32_t bandgap_delta;
+  bool stored;              // the flash block holds the calibration in use
+} adc_cal_status_t;
+
+/* @brief   Restores the stored calibration or calibrates, called by init_adc0()
+ *          with ADC0 clocked and in software trigger mode
+ *
+ * Same as adc_cal_boot_start() followed by adc_cal_boot_finish().
+ *
+ * @param   none
+ * @return  false if the hardware calibration failed or could not be stored
+ */
+bool adc_cal_boot();
+
+/* @brief   First half of adc_cal_boot(): restores and checks the stored block,
+ *          or starts the hardware calibration and returns while it runs
+ *
+ * Until adc_cal_boot_finish() nothing else may use ADC0, and the bus clock
+ * must not change.
+ *
+ * @param   none
+ * @return  true if a calibration was left running
+ */
+bool adc_cal_boot_start();
+
+/* @brief   Second half of adc_cal_boot(): waits for a calibration started by
+ *          adc_cal_boot_start(), stores it and turns averaging off
+ *
+ * @param   none
+ * @return  false if the hardware calibration failed or could not be stored
+ */
+bool adc_cal_boot_finish();
+
+/* @brief   Runs the hardware calibration and stores it, sampling must be
+ *          stopped (analog_stop())
+ *
+ * @param   none
+ * @return  false if the calibration failed or could not be stored
+ */
+bool adc_cal_run();
+
+/* @brief   Calibration source, timing and the last drift readings
+ *
+ * @param   status, filled in
+ * @return  none
+ */
+void adc_cal_get_status(adc_cal_status_t* status);
+
+#endif // _ADC_CAL_H_
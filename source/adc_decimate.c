@@ -0,0 +1,78 @@
+/*
+ * @file adc_decimate.c
+ *
+ * @brief	Polyphase FIR decimator, see adc_decimate.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <adc_decimate.h>
+
+// Kaiser (beta 5) windowed sinc, fc 3600 Hz, taps 0 .. taps/2 - 1 of the
+// symmetric filter, sum of all taps 32768
+static const int16_t coef_4x[ADC_DECIMATE_TAPS(4) / 2] = {
+  -8, 5, 31, 59, 63, 22, -66, -166, -217, -155, 37, 303,
+  513, 511, 204, -366, -984, -1313, -1020, 75, 1879, 4015, 5920, 7042
+};
+
+static const int16_t coef_8x[ADC_DECIMATE_TAPS(8) / 2] = {
+  -5, -4, 0, 6, 13, 21, 28, 33, 35, 30, 19, 2,
+  -21, -47, -74, -96, -109, -110, -94, -61, -11, 51, 120, 186,
+  240, 272, 272, 234, 156, 40, -105, -266, -423, -556, -641, -657,
+  -584, -412, -137, 235, 690, 1202, 1740, 2269, 2749, 3146, 3429, 3579
+};
+
+// see .h for more details
+bool adc_decimate_init(adc_decimate_t* d, uint32_t ratio) {
+  if (ratio == 4) {
+    d->coef = coef_4x;
+  } else if (ratio == 8) {
+    d->coef = coef_8x;
+  } else {
+    return false;
+  }
+  d->ratio = ratio;
+  d->taps = ADC_DECIMATE_TAPS(ratio);
+  return true;
+}
+
+// one output, newest is the last input of its group
+static uint16_t adc_decimate_one(const int16_t* coef, uint32_t half, const int16_t* newest,
+                                 uint32_t taps) {
+  const int16_t* oldest = newest - (taps - 1);
+  int32_t acc = 1 << 14;
+
+  // h[k] == h[taps - 1 - k], sum |h| < 1.6 so the q30 sum cannot overflow
+  for (uint32_t k = 0; k < half; k++) {
+    acc += coef[k] * ((int32_t)oldest[k] + newest[-(int32_t)k]);
+  }
+  acc >>= 15;
+  if (acc > INT16_MAX) acc = INT16_MAX;
+  if (acc < INT16_MIN) acc = INT16_MIN;
+  // back to ADC counts
+  return (uint16_t)acc ^ 0x8000U;
+}
+
+// see .h for more details
+void adc_decimate_block(const adc_decimate_t* d, uint16_t* block, uint32_t n,
+                        uint16_t* out, uint16_t* next) {
+  int16_t* x = (int16_t*)block;
+  uint32_t half = d->taps / 2;
+
+  // offset binary to two's complement, 1<<15 becomes 0
+  for (uint32_t i = 0; i < n; i++) {
+    block[i] ^= 0x8000U;
+  }
+  if (out != NULL) {
+    for (uint32_t i = d->ratio - 1; i < n; i += d->ratio) {
+      *out++ = adc_decimate_one(d->coef, half, &x[i], d->taps);
+    }
+  }
+  memmove(next, &block[n - (d->taps - 1)], (d->taps - 1) * sizeof(uint16_t));
+}
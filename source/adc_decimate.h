@@ -0,0 +1,61 @@
+/*
+ * @file adc_decimate.h
+ *
+ * @brief	Polyphase FIR decimator from an oversampled ADC rate to 8192 Hz
+ *
+ * Works like CMSIS arm_fir_decimate_q15(): only every ratio-th output of the
+ * low-pass filter is computed, so a block of n inputs costs n/ratio * taps/2
+ * multiplies (the filter is symmetric, each product covers two taps). The
+ * filters are Kaiser windowed sinc with 12 taps per polyphase branch, 48 for
+ * 4x and 96 for 8x, -6 dB at 3.6 kHz and more than 55 dB down from 5 kHz up,
+ * so nothing that aliases below 3.2 kHz gets through. DC gain is exactly 1.
+ *
+ * Blocks are processed where they lie. The taps - 1 samples in front of a
+ * block hold the end of the previous one (already in q15), and the call
+ * converts the block in place and copies its end in front of the next block.
+ * That lets a DMA ping-pong fill the blocks directly (analog_peripherals.c).
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _ADC_DECIMATE_H_
+#define _ADC_DECIMATE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADC_DECIMATE_PHASE_TAPS (12)
+#define ADC_DECIMATE_TAPS(ratio) (ADC_DECIMATE_PHASE_TAPS * (ratio))
+#define ADC_DECIMATE_MAX_RATIO  (8)
+
+typedef struct {
+  const int16_t* coef;      // first half of the symmetric filter, q15
+  uint32_t ratio;           // 4 or 8
+  uint32_t taps;
+} adc_decimate_t;
+
+/* @brief   Selects the filter for a ratio
+ *
+ * @param   d, decimator
+ *          ratio, 4 or 8
+ * @return  false if there is no filter for ratio
+ */
+bool adc_decimate_init(adc_decimate_t* d, uint32_t ratio);
+
+/* @brief   Decimates one block of ADC counts
+ *
+ * @param   d, decimator
+ *          block, n ADC counts (biased around 1<<15), converted to q15 in
+ *                 place; block[-(taps - 1)..-1] is the history
+ *          n, multiple of the ratio
+ *          out, n/ratio ADC counts, or NULL to only carry the history on
+ *          next, where the history of the following block goes, it may
+ *                overlap block (e.g. block - (taps - 1) when blocks reuse one buffer)
+ * @return  none
+ */
+void adc_decimate_block(const adc_decimate_t* d, uint16_t* block, uint32_t n,
+                        uint16_t* out, uint16_t* next);
+
+#endif // _ADC_DECIMATE_H_
@@ -12,11 +12,16 @@
  */
 
 #include <analog_peripherals.h>
+#include <adc_cal.h>
+#include <adc_decimate.h>
+#include <cpu_cycles.h>
+#include <scheduler.h>
 #include <stdio.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "MKL25Z4.h"
+#include "fsl_clock.h"
 
 #define START_CRITICAL_SECTION \
           uint32_t masking_state = __get_PRIMASK(); \
@@ -26,23 +31,108 @@
           __set_PRIMASK(masking_state)
 
 #define ADC_SAMPLING_FREQ  (8192U) // Frequency in Hz
+#define TPM0_CLK_INPUT_FREQ (48000000UL) // 48 MHz
 #define ADC_MAX_SAMPLES    (512)  
-
-
-// use a ping-pong buffer approach
-static uint16_t adc_ping[ADC_MAX_SAMPLES]; // A
-static uint16_t adc_pong[ADC_MAX_SAMPLES]; // B
+#define ADC_BLOCK_SAMPLES  (ANALOG_CHANNELS * ADC_MAX_SAMPLES)
+
+#if (ANALOG_CHANNELS != 1) && (ANALOG_CHANNELS != 2) && (ANALOG_CHANNELS != 4)
+#error "ANALOG_CHANNELS must be 1, 2 or 4"
+#endif
+
+#if (ANALOG_OVERSAMPLE != 1) && (ANALOG_OVERSAMPLE != 4) && (ANALOG_OVERSAMPLE != 8)
+#error "ANALOG_OVERSAMPLE must be 1, 4 or 8"
+#endif
+#if (ANALOG_OVERSAMPLE > 1) && (ANALOG_CHANNELS > 1)
+#error "ANALOG_OVERSAMPLE needs ANALOG_CHANNELS 1"
+#endif
+
+// hardware averaging, SC3 AVGE/AVGS after the calibration
+#if ANALOG_HW_AVERAGE == 0
+#define ADC_SC3_AVERAGE (0U)
+#elif ANALOG_HW_AVERAGE == 4
+#define ADC_SC3_AVERAGE (ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(0))
+#elif ANALOG_HW_AVERAGE == 8
+#define ADC_SC3_AVERAGE (ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(1))
+#elif ANALOG_HW_AVERAGE == 16
+#define ADC_SC3_AVERAGE (ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(2))
+#else
+#error "ANALOG_HW_AVERAGE must be 0, 4, 8 or 16"
+#endif
+
+// TPM0 overflows per frame sample
+#define ADC_TRIGGERS_PER_SAMPLE (ANALOG_CHANNELS * ANALOG_OVERSAMPLE)
+
+// the channel select DMA, channel 1 belongs to the debug console
+#define DMA_SEQ_CHANNEL     (2)
+// estimated cycle-steal transfer through the peripheral bridge
+#define ANALOG_DMA_BUS_CYCLES (8U)
+
+// use a ping-pong buffer approach, interleaved while DMA0 fills it
+static uint16_t adc_ping[ADC_BLOCK_SAMPLES]; // A
+static uint16_t adc_pong[ADC_BLOCK_SAMPLES]; // B
 // the status flags
 static volatile bool adc_ping_active;
 static volatile bool adc_pong_full;
 
+static const uint8_t adc_inputs[] = { ANALOG_CHANNEL_INPUTS };
+_Static_assert(sizeof(adc_inputs) >= ANALOG_CHANNELS, "ANALOG_CHANNEL_INPUTS lists too few inputs");
+
+#if ANALOG_OVERSAMPLE > 1
+// frame samples per DMA block, the decimator runs in DMA0_IRQHandler
+#define ADC_OS_OUT     (64)
+#define ADC_OS_BLOCK   (ANALOG_OVERSAMPLE * ADC_OS_OUT)
+#define ADC_OS_HISTORY (ADC_DECIMATE_TAPS(ANALOG_OVERSAMPLE) - 1)
+#define ADC_DMA_SAMPLES ADC_OS_BLOCK
+
+// DMA0 ping-pongs between these at the oversampled rate, each block is
+// preceded by the filter history (adc_decimate.h)
+static uint16_t adc_os[2][ADC_OS_HISTORY + ADC_OS_BLOCK];
+static uint32_t adc_os_active;            // block DMA0 fills
+static volatile uint32_t adc_frame_fill;  // decimated samples in the frame being filled
+static adc_decimate_t adc_dec;
+static analog_decimate_stats_t dec_stats;
+#else
+#define ADC_DMA_SAMPLES ADC_BLOCK_SAMPLES
+#endif
+
+#if ANALOG_CHANNELS > 1
+// SC1 values DMA channel 2 writes after each result, entry i selects the
+// input of the conversion after the one that just finished. 16 bytes so SMOD
+// wraps it, 2 channels repeat twice
+static uint32_t adc_sequence[4] __attribute__((aligned(16)));
+#endif
+
+static void adc0_configure();
+static void adc0_arm();
+static void adc_sequence_restart();
+static uint16_t* adc_os_restart();
+
+// SC1[0] value of a channel, conversions start on the TPM0 trigger only
+static uint32_t adc_sc1(uint32_t channel) {
+  return ADC_SC1_ADCH(adc_inputs[channel]) | ADC_SC1_AIEN(0) | ADC_SC1_DIFF(0);
+}
+
 // initializes the analog module to a known state using internal/public functions
 void analog_init() {
+  analog_init_begin();
+  analog_init_end();
+}
+
+
+// DMA0/TPM0 set up, ADC0 configured and its calibration started
+void analog_init_begin() {
 
   // init dma0, tpm0, adc0
   init_dma0();
   init_tpm0();
-  init_adc0();
+  adc0_configure();
+}
+
+
+// waits for the ADC0 calibration and starts sampling
+void analog_init_end() {
+
+  adc0_arm();
 
   // DMA sets the PING side of the double buffer to be filled first
   adc_ping_active = true;
@@ -53,12 +143,134 @@ void analog_init() {
 }
 
 
+// halts sampling before a stop mode, ADC0/DMA0 keep their configuration
+void analog_stop() {
+
+  START_CRITICAL_SECTION;
+  // no more TPM0 triggers, then no more DMA requests
+  TPM0->SC &= ~TPM_SC_CMOD_MASK;
+  DMA0->DMA[0].DCR &= ~DMA_DCR_ERQ_MASK;
+  // drop the partly filled block, the leftover count stays in BCR until
+  // analog_restart() assigns a full one
+  DMA0->DMA[0].DSR_BCR |= DMA_DSR_BCR_DONE_MASK;
+  NVIC_ClearPendingIRQ(DMA0_IRQn);
+  adc_pong_full = false;
+  END_CRITICAL_SECTION;
+}
+
+
+// restarts sampling into the PING buffer from an empty state
+void analog_restart() {
+
+  START_CRITICAL_SECTION;
+  adc_ping_active = true;
+  adc_pong_full = false;
+  DMA0->DMA[0].DAR = DMA_DAR_DAR((uint32_t)adc_os_restart());
+  // analog_stop() left the unfinished count in BCR, OR-ing a full block
+  // into it would run past the buffer: clear, then assign
+  DMA0->DMA[0].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+  DMA0->DMA[0].DSR_BCR = DMA_DSR_BCR_BCR(2*ADC_DMA_SAMPLES);
+  // the block starts with channel 0 again
+  ADC0->SC1[0] = adc_sc1(0);
+  adc_sequence_restart();
+  DMA0->DMA[0].DCR |= DMA_DCR_ERQ_MASK;
+  TPM0->CNT = 0;
+  TPM0->SC |= TPM_SC_CMOD(1);
+  END_CRITICAL_SECTION;
+}
+
+
+// samples still to come before the block being filled is complete
+uint32_t analog_samples_remaining() {
+  if (adc_pong_full) {
+    return 0;
+  }
+  uint32_t left = (DMA0->DMA[0].DSR_BCR & DMA_DSR_BCR_BCR_MASK) >> 1;
+#if ANALOG_OVERSAMPLE > 1
+  // the rest of this DMA block plus the blocks still to come
+  uint32_t used = adc_frame_fill + (ADC_OS_BLOCK - left) / ANALOG_OVERSAMPLE;
+  return (used < ADC_MAX_SAMPLES) ? ADC_MAX_SAMPLES - used : 0;
+#else
+  // one sample period is ANALOG_CHANNELS results
+  return left / ANALOG_CHANNELS;
+#endif
+}
+
+
+// see .h for more details
+uint32_t analog_irq_slack() {
+  uint32_t left = analog_samples_remaining();
+#if ANALOG_OVERSAMPLE > 1
+  uint32_t block = ((DMA0->DMA[0].DSR_BCR & DMA_DSR_BCR_BCR_MASK) >> 1) / ANALOG_OVERSAMPLE;
+  if (block < left) {
+    left = block;
+  }
+#endif
+  return left;
+}
+
+
 // this functions checks to swap writing/reading order
 bool is_adc_pong_full() {
   return adc_pong_full;
 }
 
 
+// first DMA0 destination after a (re)start, with oversampling the filter
+// starts from silence and the frame from empty
+static uint16_t* adc_os_restart() {
+#if ANALOG_OVERSAMPLE > 1
+  adc_os_active = 0;
+  adc_frame_fill = 0;
+  for (uint32_t i = 0; i < ADC_OS_HISTORY; i++) {
+    adc_os[0][i] = 0;
+  }
+  return &adc_os[0][ADC_OS_HISTORY];
+#else
+  return adc_ping;
+#endif
+}
+
+// channel 2 back to the start of the table with a full block to go, call
+// with DMA0 idle or between blocks
+static void adc_sequence_restart() {
+#if ANALOG_CHANNELS > 1
+  DMA0->DMA[DMA_SEQ_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+  DMA0->DMA[DMA_SEQ_CHANNEL].SAR = DMA_SAR_SAR((uint32_t)&(adc_sequence[0]));
+  DMA0->DMA[DMA_SEQ_CHANNEL].DSR_BCR = DMA_DSR_BCR_BCR(4*ADC_BLOCK_SAMPLES);
+#endif
+}
+
+#if ANALOG_OVERSAMPLE == 1
+// in place de-interleave of a 2 way interleaved run of n (power of two)
+// samples: each pass swaps the middle quarters of every block of size b,
+// which turns [e o e o | e o e o] into [e e o o | e e o o] and so on up
+static void adc_unshuffle(uint16_t* x, uint32_t n) {
+  for (uint32_t b = 4; b <= n; b <<= 1) {
+    uint32_t q = b >> 2;
+    for (uint32_t s = q; s < n; s += b) {
+      for (uint32_t i = s; i < s + q; i++) {
+        uint16_t t = x[i];
+        x[i] = x[i + q];
+        x[i + q] = t;
+      }
+    }
+  }
+}
+
+// block of ANALOG_CHANNELS interleaved results to one frame per channel,
+// (ADC_BLOCK_SAMPLES / 4) * log2(ADC_BLOCK_SAMPLES) swaps per pass
+static void adc_deinterleave(uint16_t* block) {
+  if (ANALOG_CHANNELS >= 2) {
+    adc_unshuffle(block, ADC_BLOCK_SAMPLES);
+  }
+  if (ANALOG_CHANNELS == 4) {
+    adc_unshuffle(block, ADC_BLOCK_SAMPLES / 2);
+    adc_unshuffle(block + ADC_BLOCK_SAMPLES / 2, ADC_BLOCK_SAMPLES / 2);
+  }
+}
+#endif
+
 // begins keeping track of the buffer's sampled as they are retrieved by DMA
 uint16_t* get_samples() {
 
@@ -71,6 +283,15 @@ uint16_t* get_samples() {
   // the return buffer:
   uint16_t* process_buffer_return;
 
+#if ANALOG_OVERSAMPLE > 1
+  // DMA0 runs on its own blocks, only the frames swap
+  START_CRITICAL_SECTION;
+  process_buffer_return = adc_ping_active ? adc_ping : adc_pong;
+  adc_ping_active = !adc_ping_active;
+  adc_frame_fill = 0;
+  adc_pong_full = false;
+  END_CRITICAL_SECTION;
+#else
   // disable interrupts when swapping buffers
   START_CRITICAL_SECTION;
 
@@ -92,27 +313,138 @@ uint16_t* get_samples() {
   // when pong is not filled, we know that the ping buffer is used in FFT
   adc_pong_full = false;
 
-  // re-start DMA0
-  DMA0->DMA[0].DSR_BCR |= DMA_DSR_BCR_BCR(2*ADC_MAX_SAMPLES);
+  // re-start DMA0, the channel select table is back at its start
+  DMA0->DMA[0].DSR_BCR |= DMA_DSR_BCR_BCR(2*ADC_BLOCK_SAMPLES);
+  adc_sequence_restart();
   DMA0->DMA[0].DCR |= DMA_DCR_ERQ_MASK;
 
   // restore context and interrupt priority
   END_CRITICAL_SECTION;
 
+  // ch0 ch1 .. ch0 ch1 .. to one frame per channel
+  adc_deinterleave(process_buffer_return);
+#endif
+
   // return buffer for processing
   return process_buffer_return;
 }
 
+// the block get_samples() returned last, DMA0 fills the other one
+const uint16_t* analog_last_samples() {
+  return adc_ping_active ? adc_pong : adc_ping;
+}
+
+// where a channel's frame ends up after adc_deinterleave()
+static uint32_t adc_channel_slot(uint32_t channel) {
+  // each unshuffle pass sorts by the next bit of the channel number, so the
+  // frames come out in bit reversed order (0 2 1 3 for 4 channels)
+  return (ANALOG_CHANNELS == 4) ? (((channel & 1U) << 1) | (channel >> 1)) : channel;
+}
+
+// see .h for more details
+const uint16_t* analog_channel_samples(uint32_t channel) {
+  if (channel >= ANALOG_CHANNELS) {
+    return NULL;
+  }
+  return analog_last_samples() + adc_channel_slot(channel) * ADC_MAX_SAMPLES;
+}
+
+// see .h for more details
+void analog_get_capacity(analog_capacity_t* capacity) {
+  static const uint8_t bct_se[] = { 17, 20, 20, 25 };     // 8, 12, 10, 16-bit, ADCK cycles
+  static const uint8_t bct_diff[] = { 27, 30, 30, 34 };   // 9, 13, 11, 16-bit
+  static const uint8_t lst[] = { 20, 12, 6, 2 };          // ADLSTS, long sample adder
+  uint32_t bus = CLOCK_GetBusClkFreq();
+  uint32_t cfg1 = ADC0->CFG1;
+  uint32_t cfg2 = ADC0->CFG2;
+  uint32_t sc3 = ADC0->SC3;
+  uint32_t mode = (cfg1 & ADC_CFG1_MODE_MASK) >> ADC_CFG1_MODE_SHIFT;
+
+  // ADICLK 0 bus, 1 bus/2, the asynchronous clock is not used here
+  uint32_t adck = ((cfg1 & ADC_CFG1_ADICLK_MASK) == ADC_CFG1_ADICLK(1)) ? bus / 2U : bus;
+  adck >>= (cfg1 & ADC_CFG1_ADIV_MASK) >> ADC_CFG1_ADIV_SHIFT;
+  uint32_t per = (ADC0->SC1[0] & ADC_SC1_DIFF_MASK) ? bct_diff[mode] : bct_se[mode];
+  if (cfg1 & ADC_CFG1_ADLSMP_MASK) {
+    per += lst[(cfg2 & ADC_CFG2_ADLSTS_MASK) >> ADC_CFG2_ADLSTS_SHIFT];
+  }
+  if (cfg2 & ADC_CFG2_ADHSC_MASK) {
+    per += 2U;
+  }
+  uint32_t average = (sc3 & ADC_SC3_AVGE_MASK) ? (4U << ((sc3 & ADC_SC3_AVGS_MASK) >> ADC_SC3_AVGS_SHIFT)) : 1U;
+  uint32_t adck_cycles = 3U + average * per;
+  uint32_t bus_cycles = 5U + ANALOG_DMA_BUS_CYCLES * ((ANALOG_CHANNELS > 1) ? 2U : 1U);
+
+  // ns = cycles * 1e9 / f, in two steps so nothing overflows
+  capacity->conversion_ns = (adck_cycles * 1000000U) / (adck / 1000U) +
+                            (bus_cycles * 1000000U) / (bus / 1000U);
+  capacity->max_rate = 1000000000U / capacity->conversion_ns;
+  capacity->max_channels = capacity->max_rate / (ADC_SAMPLING_FREQ * ANALOG_OVERSAMPLE);
+  capacity->channels = ANALOG_CHANNELS;
+  capacity->trigger_hz = TPM0_CLK_INPUT_FREQ / (TPM0->MOD + 1U);
+  capacity->channel_mhz = (uint32_t)((TPM0_CLK_INPUT_FREQ * 1000ULL) / ((TPM0->MOD + 1U) * ADC_TRIGGERS_PER_SAMPLE));
+}
+
 // this is the standard DMA handler that clears the DMA transfer flag
 void DMA0_IRQHandler() {
   // clear done flag
   DMA0->DMA[0].DSR_BCR |= DMA_DSR_BCR_DONE_MASK;
+#if ANALOG_OVERSAMPLE > 1
+  uint32_t start = cpu_cycles_now();
+  uint16_t* done = &adc_os[adc_os_active][ADC_OS_HISTORY];
+
+  // the next block first, a conversion is due every 1/(8192 * ANALOG_OVERSAMPLE) s
+  adc_os_active ^= 1U;
+  uint16_t* next = &adc_os[adc_os_active][0];
+  DMA0->DMA[0].DAR = DMA_DAR_DAR((uint32_t)&next[ADC_OS_HISTORY]);
+  DMA0->DMA[0].DSR_BCR |= DMA_DSR_BCR_BCR(2*ADC_OS_BLOCK);
+  DMA0->DMA[0].DCR |= DMA_DCR_ERQ_MASK;
+
+  // while a full frame waits for get_samples() its outputs are dropped,
+  // like the single rate blocks, but the filter history carries on
+  uint16_t* frame = adc_ping_active ? adc_ping : adc_pong;
+  uint16_t* out = adc_pong_full ? NULL : &frame[adc_frame_fill];
+  adc_decimate_block(&adc_dec, done, ADC_OS_BLOCK, out, next);
+
+  uint32_t cycles = cpu_cycles_since(start);
+  dec_stats.blocks++;
+  dec_stats.cycles_total += cycles;
+  if (cycles > dec_stats.cycles_max) {
+    dec_stats.cycles_max = cycles;
+  }
+  if (out == NULL) {
+    return;
+  }
+  adc_frame_fill += ADC_OS_OUT;
+  if (adc_frame_fill < ADC_MAX_SAMPLES) {
+    return;
+  }
+#endif
   // samples are now available
   adc_pong_full = true;
+  sched_post_isr(SCHED_TASK_DSP, SCHED_EV_FRAME);
+}
+
+// see .h for more details
+void analog_get_decimate_stats(analog_decimate_stats_t* stats) {
+#if ANALOG_OVERSAMPLE > 1
+  START_CRITICAL_SECTION;
+  *stats = dec_stats;
+  END_CRITICAL_SECTION;
+#else
+  stats->blocks = 0;
+  stats->cycles_total = 0;
+  stats->cycles_max = 0;
+#endif
 }
 
 // ADC0 initialized similar to Lab7, except we are using a different pin
 void init_adc0() {
+  adc0_configure();
+  adc0_arm();
+}
+
+// clocking, 16-bit mode and software triggering, the calibration is left running
+static void adc0_configure() {
   // enable clock gating
   SIM->SCGC6 |= SIM_SCGC6_ADC0_MASK;
   // enable alternate trigger pg. 201
@@ -136,30 +468,23 @@ void init_adc0() {
   // set adc0 input to SE15
   // PORTC1
   // AIEN and DIFF set to standard configuration
-  ADC0->SC1[0] = ADC_SC1_ADCH(15) | ADC_SC1_AIEN(0) | ADC_SC1_DIFF(0);
-
-  // run calibration datasheet sec 28.4.6:
-  // turn on averaging (32) temporarily for calibration sequence
-  ADC0->SC3 |= ADC_SC3_CAL_MASK | ADC_SC3_AVGS(3);
-  // start calibration
-  while(!(ADC0->SC1[0] & ADC_SC1_COCO_MASK)) {;} // wait for calibration complete
-
-  // plus-side calibration
-  uint16_t cal = 0;
-  cal = ADC0->CLP0+ADC0->CLP1+ADC0->CLP2+ADC0->CLP3+ADC0->CLP4+ADC0->CLPS;
-  cal = cal/2;
-  cal |= (1<<15); // set MSB
-  ADC0->PG = cal; // write calibration
-
-  // minus-side calibration
-  cal = 0;
-  cal = ADC0->CLM0+ADC0->CLM1+ADC0->CLM2+ADC0->CLM3+ADC0->CLM4+ADC0->CLMS;
-  cal = cal/2;
-  cal |= (1<<15); // set MSB
-  ADC0->MG = cal; // write calibration
-
-  // disable averaging
-  ADC0->SC3 &= ~(ADC_SC3_AVGS_MASK);
+  ADC0->SC1[0] = adc_sc1(0);
+
+  // calibration datasheet sec 28.4.6: restored from flash when the stored
+  // one still holds, otherwise started here (32x averaging), see adc_cal.h
+  adc_cal_boot_start();
+}
+
+// finishes the calibration and hands ADC0 to TPM0 triggering and DMA0
+static void adc0_arm() {
+  // waits for a calibration that is still running and stores it,
+  // averaging is off again afterwards
+  adc_cal_boot_finish();
+
+  // back to the microphone input, no conversion starts until hardware triggering is on
+  ADC0->SC1[0] = adc_sc1(0);
+  // hardware averaging if built with it, before the first trigger
+  ADC0->SC3 = ADC_SC3_AVERAGE;
   // re-enable hardware triggering
   // enable dma request
   ADC0->SC2 |= ADC_SC2_ADTRG(1) | ADC_SC2_DMAEN(1);
@@ -184,19 +509,44 @@ void init_dma0() {
   // DSIZE - sets destination size to 16 bits
   // D_REQ - DCR ERQ bit is cleared when BCR is depleted
   // CS    - force single read/write per request (cycle steal)
+  // LINKCC - more than one channel: after each transfer link to channel 2,
+  //          which selects the input of the next conversion
   DMA0->DMA[0].DCR = ( DMA_DCR_EINT_MASK  |
                        DMA_DCR_ERQ_MASK   |
                        DMA_DCR_DINC_MASK  |
                        DMA_DCR_SSIZE(2)   |
                        DMA_DCR_DSIZE(2)   |
                        DMA_DCR_D_REQ_MASK |
-                       DMA_DCR_CS_MASK    );
+                       DMA_DCR_CS_MASK    |
+                       ((ANALOG_CHANNELS > 1) ?
+                        (DMA_DCR_LINKCC(2) | DMA_DCR_LCH1(DMA_SEQ_CHANNEL)) : 0) );
 
   // setup source from adc0, dest to adc_samples
   DMA0->DMA[0].SAR = DMA_SAR_SAR((uint32_t)&(ADC0->R[0]));
-  DMA0->DMA[0].DAR = DMA_DAR_DAR((uint32_t)&(adc_ping[0]));
-  // load BCR with ADC_MAX_SAMPLES*2 bytes (16-bits) per transfer 
-  DMA0->DMA[0].DSR_BCR |= DMA_DSR_BCR_BCR(2*ADC_MAX_SAMPLES);
+  DMA0->DMA[0].DAR = DMA_DAR_DAR((uint32_t)adc_os_restart());
+  // load BCR with ADC_DMA_SAMPLES*2 bytes (16-bits) per transfer 
+  DMA0->DMA[0].DSR_BCR |= DMA_DSR_BCR_BCR(2*ADC_DMA_SAMPLES);
+#if ANALOG_OVERSAMPLE > 1
+  adc_decimate_init(&adc_dec, ANALOG_OVERSAMPLE);
+#endif
+
+#if ANALOG_CHANNELS > 1
+  // entry i is the input after result i, the last one wraps to channel 0
+  for (uint32_t i = 0; i < 4; i++) {
+    adc_sequence[i] = adc_sc1((i + 1) % ANALOG_CHANNELS);
+  }
+  // channel 2 only runs when channel 0 links to it, no DMAMUX source
+  // SINC/SMOD - 32-bit reads walking the 16 byte table circularly
+  // CS        - one SC1 write per link
+  DMAMUX0->CHCFG[DMA_SEQ_CHANNEL] = 0;
+  DMA0->DMA[DMA_SEQ_CHANNEL].DCR = ( DMA_DCR_SINC_MASK |
+                                     DMA_DCR_SSIZE(0)  |
+                                     DMA_DCR_DSIZE(0)  |
+                                     DMA_DCR_SMOD(1)   |
+                                     DMA_DCR_CS_MASK   );
+  DMA0->DMA[DMA_SEQ_CHANNEL].DAR = DMA_DAR_DAR((uint32_t)&(ADC0->SC1[0]));
+  adc_sequence_restart();
+#endif
   
   // configure the interrupt upon transfer complete, priority 
   NVIC_SetPriority(DMA0_IRQn, 2);
@@ -209,7 +559,6 @@ void init_dma0() {
 }
 
 
-#define TPM0_CLK_INPUT_FREQ (48000000UL) // 48 MHz
 // TPM0 module sets the sampling frequency for the ADC0 at 48000Khz (Studio Quality)
 void init_tpm0() {
 
@@ -226,7 +575,11 @@ void init_tpm0() {
   // KL25Z datasheet sec. 31.3.7
   TPM0->CONF |= TPM_CONF_DBGMODE(0b11);
   // set the overflow - KL25Z datasheet sec. 31.3.3
-  TPM0->MOD = TPM0_CLK_INPUT_FREQ/ADC_SAMPLING_FREQ - 1;
+  // each channel is converted on every ANALOG_CHANNELS-th overflow, and
+  // ANALOG_OVERSAMPLE times per frame sample. 48 MHz does not divide into
+  // 8192 Hz, MOD is rounded to the nearest count: 8192.5 Hz for 1 trigger per
+  // sample, 8191.1 Hz for 2 or 4, 8196.7 Hz for 8 (analog_get_capacity())
+  TPM0->MOD = (2*TPM0_CLK_INPUT_FREQ/(ADC_SAMPLING_FREQ * ADC_TRIGGERS_PER_SAMPLE) + 1)/2 - 1;
   // clear counter 
   TPM0->CNT = 0;
   // TPM0 will be started when reading samples
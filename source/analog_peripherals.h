@@ -7,6 +7,41 @@
  *
  * Single ended 16-bit analog samples are recorded from KL25Z PortC, Pin1 (PTC1)
  *
+ * With ANALOG_CHANNELS > 1 the microphones are sampled in turn. TPM0 triggers
+ * ANALOG_CHANNELS times per sample period and DMA0 links to DMA channel 2
+ * after every result, which writes the next input of a 16 byte circular
+ * table (SMOD) into ADC0->SC1[0] ("DMA reloaded channel select"). Every
+ * channel is converted on every ANALOG_CHANNELS-th trigger, so all channels
+ * have the same rate, 48 MHz / (ANALOG_CHANNELS * (TPM0 MOD + 1)), and are
+ * 1/ANALOG_CHANNELS of a period apart. MOD is rounded, so that rate is
+ * 8192.5 Hz for one channel, 8191.1 Hz for 2 or 4 and 8196.7 Hz with 8x
+ * oversampling, within 0.06% of 8192 Hz (1 cent). The circular table is why only 1, 2
+ * or 4 channels are supported. A block is ANALOG_CHANNELS * 512 interleaved
+ * results; get_samples() de-interleaves it in place so each channel is a
+ * contiguous 512 sample frame (analog_channel_samples()).
+ *
+ * ANALOG_OVERSAMPLE runs ADC0 at 4x or 8x the frame rate instead. DMA0 then
+ * ping-pongs between blocks of 64 frame samples (256 or 512 conversions),
+ * and DMA0_IRQHandler decimates each block into the frame being filled with
+ * the polyphase low-pass in adc_decimate.h. Noise is spread over the wider
+ * band, and the filter removes what falls above 3.6 kHz before it can alias.
+ * That is +6 dB (4x) or +9 dB (8x) SNR for white ADC noise, and out of band
+ * tones are 55 dB down. The 512 point FFT stays the same, and the frame rate
+ * and get_samples() behave as before. Hardware averaging (ANALOG_HW_AVERAGE)
+ * costs no CPU, but its conversions come back to back within about 20-80 us,
+ * so it only lowers the ADC's own noise and does nothing against aliasing.
+ * tools/host test_decimate compares the options.
+ *
+ * Build options:
+ * 	ANALOG_CHANNELS         microphones, 1, 2 or 4 (default 1)
+ * 	ANALOG_CHANNEL_INPUTS   ADC0 inputs in channel order (default 15, 11, 13, 12:
+ * 	                        PTC1, PTC2, PTB3, PTB2), the first ANALOG_CHANNELS are used
+ * 	ANALOG_OVERSAMPLE       conversions per frame sample, 1, 4 or 8 (default 1),
+ * 	                        ANALOG_CHANNELS must be 1
+ * 	ANALOG_HW_AVERAGE       ADC0 hardware average per conversion, 0 (off), 4, 8 or 16,
+ * 	                        the averaged conversion must fit the trigger period
+ * 	                        (analog_get_capacity())
+ *
  * @author  Ishmael Pelayo
  * @date    12-09-2022
  * @rev     1.2
@@ -19,6 +54,38 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifndef ANALOG_CHANNELS
+#define ANALOG_CHANNELS (1)
+#endif
+
+#ifndef ANALOG_CHANNEL_INPUTS
+#define ANALOG_CHANNEL_INPUTS 15, 11, 13, 12
+#endif
+
+#ifndef ANALOG_OVERSAMPLE
+#define ANALOG_OVERSAMPLE (1)
+#endif
+
+#ifndef ANALOG_HW_AVERAGE
+#define ANALOG_HW_AVERAGE (0)
+#endif
+
+// what ADC0 and the DMA can sustain with the current configuration
+typedef struct {
+  uint32_t channels;        // ANALOG_CHANNELS
+  uint32_t trigger_hz;      // TPM0 overflows per second, all channels
+  uint32_t channel_mhz;     // sample rate of every channel, in mHz
+  uint32_t conversion_ns;   // one conversion plus its DMA transfers
+  uint32_t max_rate;        // conversions per second that fit back to back
+  uint32_t max_channels;    // channels at the 8192 Hz rate (times ANALOG_OVERSAMPLE) within max_rate
+} analog_capacity_t;
+
+// cost of the decimation in DMA0_IRQHandler, ANALOG_OVERSAMPLE > 1
+typedef struct {
+  uint32_t blocks;          // DMA blocks decimated
+  uint64_t cycles_total;    // core cycles in the handler
+  uint32_t cycles_max;
+} analog_decimate_stats_t;
 
 /*
  * @brief  invokes a writing operation to the active buffer
@@ -27,7 +94,8 @@
  * current data remains recent.
  *
  * @params  none
- * @return uint16_t*, a buffer containing 512 ADC samples
+ * @return uint16_t*, a buffer containing 512 ADC samples of channel 0, the
+ *                    other channels via analog_channel_samples()
  *                    NULL if ADC is not available
  */
 uint16_t* get_samples();
@@ -41,6 +109,48 @@ uint16_t* get_samples();
  */
 bool is_adc_pong_full();
 
+/*
+ * @brief   The block get_samples() returned last, e.g. for the shell `bench`
+ *
+ * @params  none
+ * @return  512 samples, overwritten after the next get_samples() swap
+ */
+const uint16_t* analog_last_samples();
+
+/*
+ * @brief   One channel of the block get_samples() returned last
+ *
+ * @params  channel, 0 to ANALOG_CHANNELS - 1
+ * @return  512 samples, overwritten after the next get_samples() swap,
+ *          NULL if channel is out of range
+ */
+const uint16_t* analog_channel_samples(uint32_t channel);
+
+/*
+ * @brief   Sample rates and the limit of the ADC0/DMA path, e.g. for `counters`
+ *
+ * The conversion time follows the reference manual (sec. 28.4.4.5) for the
+ * CFG1/CFG2/SC3 settings in use: 3 ADCK + 5 bus cycles of start-up plus 25
+ * ADCK per 16-bit single ended conversion, times the hardware average. The
+ * DMA adds ANALOG_DMA_BUS_CYCLES per transfer, two per result with more than
+ * one channel (the result and the next SC1). With the default 6 MHz ADCK
+ * this is about 180000 conversions per second, i.e. around 22 channels at
+ * 8192 Hz, far above the 4 this module sequences.
+ *
+ * @params  capacity, filled in
+ * @return  none
+ */
+void analog_get_capacity(analog_capacity_t* capacity);
+
+/*
+ * @brief   Cycles DMA0_IRQHandler spent decimating, all zero without
+ *          ANALOG_OVERSAMPLE
+ *
+ * @params  stats, filled in
+ * @return  none
+ */
+void analog_get_decimate_stats(analog_decimate_stats_t* stats);
+
 /*
  * @brief   Initializes ADC0, DMA0, and TPM0 
  *
@@ -53,6 +163,72 @@ bool is_adc_pong_full();
  */
 void analog_init();
 
+/*
+ * @brief   First half of analog_init(): DMA0 and TPM0 set up, ADC0 configured
+ *          and its calibration started (adc_cal_boot_start())
+ *
+ * A hardware calibration runs for a few milliseconds. Work that does not
+ * use ADC0 or change the bus clock can go between this and analog_init_end().
+ *
+ * @params   none
+ * @return  none
+ */
+void analog_init_begin();
+
+/*
+ * @brief   Second half of analog_init(): waits for the calibration and starts
+ *          sampling, the first block is ready 62.5 ms later
+ *
+ * @params   none
+ * @return  none
+ */
+void analog_init_end();
+
+/*
+ * @brief   Time left, in samples, until the block being filled is ready
+ *
+ * Each sample is 1/8192 s (~122 us), whatever ANALOG_CHANNELS is. Work
+ * that cannot be interrupted (flash programming, see capture_log.h) uses it
+ * to fit between frames.
+ *
+ * @params   none
+ * @return  samples left in the DMA block, 0 when a block is waiting
+ */
+uint32_t analog_samples_remaining();
+
+/*
+ * @brief   Time left, in samples, before DMA0_IRQHandler must run to keep sampling
+ *
+ * Work that masks interrupts uses this one. Without oversampling it is
+ * analog_samples_remaining(). With ANALOG_OVERSAMPLE the handler re-arms DMA0
+ * after every 64-sample DMA block and has one conversion to do it, so only
+ * what is left of the current DMA block counts.
+ *
+ * @params   none
+ * @return  samples left before the DMA0 interrupt is due
+ */
+uint32_t analog_irq_slack();
+
+/*
+ * @brief   Stops TPM0 and DMA0 so no samples are taken, e.g. before a stop mode
+ *
+ * The partly filled block is discarded.
+ *
+ * @params   none
+ * @return  none
+ */
+void analog_stop();
+
+/*
+ * @brief   Starts sampling again after analog_stop()
+ *
+ * The first block is ready 512 samples (62.5 ms) later.
+ *
+ * @params   none
+ * @return  none
+ */
+void analog_restart();
+
 /*
  * @brief   Initializes ADC0 for sampling via TPM0 overflow
  *
@@ -65,7 +241,8 @@ void analog_init();
 void init_adc0();
 
 /*
- * @brief  Initializes DMA channel 0 for retrieving ADC values
+ * @brief  Initializes DMA channel 0 for retrieving ADC values, and channel 2
+ *         for the channel select when ANALOG_CHANNELS > 1
  *
  * @param   none
  * @return  none
@@ -81,7 +258,7 @@ void init_dma0();
 void DMA0_IRQHandler();
 
 /*
- * @brief   Initializes TPM0 overflow at ADC_SAMPLING_FREQ in Hz
+ * @brief   Initializes TPM0 overflow at ADC_SAMPLING_FREQ * ANALOG_CHANNELS in Hz
  *
  * @param   none
  * @return  none
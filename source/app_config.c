@@ -0,0 +1,34 @@
+/*
+ * @file app_config.c
+ *
+ * @brief	Power-on defaults of the runtime settings, see app_config.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <app_config.h>
+#include <touch_sensor.h>
+#include <standby.h>
+#include <sample_codec.h>
+
+app_config_t app_config = {
+  .tsi_threshold = TSI_THRESHOLD,
+  .tsi_scan_hz   = TSI_SCAN_HZ,
+  .min_magnitude = 0,
+  .standby_s     = STANDBY_IDLE_SECONDS,
+  .detector      = DETECTOR_FORMANT,
+  .mode          = MODE_TOUCH,
+  .capture       = 0,
+  .codec         = CODEC_ADPCM,
+  .verbosity     = 1,
+#if defined(TELEMETRY_DISABLE)
+  .telemetry     = 0,
+#else
+  .telemetry     = 1,
+#endif
+  .dc_block      = 1,
+  .notes         = 1,
+  .frames        = 0
+};
@@ -0,0 +1,58 @@
+/*
+ * @file app_config.h
+ *
+ * @brief	Runtime settings of the pitch detector, changed from the UART shell
+ * 			(shell.h) without reflashing
+ *
+ * Fields start at the compile-time value the firmware used before the shell
+ * existed, with three exceptions that change what an untouched board does:
+ * 	dc_block   1: the mic bias is tracked, not fixed at 1<<15 (set dc_block 0)
+ * 	notes      1: continuous mode reports note-on/off events, not every frame
+ * 	           (set notes 0)
+ * 	telemetry  1: a binary COBS record goes to the console every frame
+ * 	           (set telemetry 0, or build with TELEMETRY_DISABLE)
+ * standby_s starts at STANDBY_IDLE_SECONDS, 0 by default, so the board never
+ * sleeps on its own; set standby_s 30 enters standby after 30 idle seconds.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _APP_CONFIG_H_
+#define _APP_CONFIG_H_
+
+#include <stdint.h>
+
+// which pitch result main() reports
+typedef enum {
+  DETECTOR_FORMANT = 0,   // dsp_fft_max_pitch(), argmax with the B5 correction
+  DETECTOR_ARGMAX  = 1    // dsp_fft_peak_bin(), strongest bin only
+} detector_t;
+
+// when main() reports a pitch
+typedef enum {
+  MODE_TOUCH      = 0,    // once per press of the touch slider
+  MODE_CONTINUOUS = 1,    // every frame
+  MODE_TUNER      = 2     // every frame as note, octave and cents (tuner.h)
+} run_mode_t;
+
+typedef struct {
+  int32_t tsi_threshold;  // counts above baseline that count as a press (touch_set_threshold)
+  int32_t min_magnitude;  // peak power below which no pitch is reported (slider or shell)
+  int32_t detector;       // detector_t
+  int32_t tsi_scan_hz;    // touch channel sweeps per second, 0 continuous (touch_set_scan_rate)
+  int32_t standby_s;      // untouched seconds before standby (standby.h), 0 never
+  int32_t mode;           // run_mode_t
+  int32_t capture;        // capture_mode_t, what goes to the flash log (capture_log.h)
+  int32_t codec;          // codec_t, how captured frames are stored (sample_codec.h)
+  int32_t verbosity;      // 0 silent, 1 pitch reports, 2 also one line per frame
+  int32_t telemetry;      // 0 off, 1 binary telemetry records every frame
+  int32_t dc_block;       // 1 track the mic bias (dsp_fft_mag_dc), 0 fixed 1<<15 as before
+  int32_t notes;          // continuous mode reports: 1 note-on/off events (note_tracker.h), 0 every frame
+  uint32_t frames;        // frames processed since reset (status, not a setting)
+} app_config_t;
+
+extern app_config_t app_config;
+
+#endif // _APP_CONFIG_H_
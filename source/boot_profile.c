@@ -0,0 +1,121 @@
+/*
+ * @file boot_profile.c
+ *
+ * @brief	Boot phase stamps and the split clock bring-up, see boot_profile.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "MKL25Z4.h"
+#include "fsl_clock.h"
+#include "clock_config.h"
+#include <cpu_cycles.h>
+#include <boot_profile.h>
+
+// MCG_S[CLKST] values, the SDK keeps its enum private
+#define MCG_CLKST_EXTERNAL (2U)
+#define MCG_CLKST_PLL      (3U)
+
+static boot_record_t records[BOOT_PROFILE_RECORDS];
+static uint32_t record_count;
+static uint32_t last_stamp;     // SysTick was started from 0 in ResetISR
+static uint32_t phase_hz;       // core clock at the last mark
+static bool finished;
+
+// see .h for more details
+void boot_profile_start(void) {
+  SysTick->CTRL = 0;
+  SysTick->LOAD = CPU_CYCLES_MASK;
+  SysTick->VAL = 0;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+#if !defined(BOOT_PROFILE_DISABLE)
+// see .h for more details
+void boot_profile_mark(boot_phase_t phase) {
+  uint32_t now = cpu_cycles_now();
+
+  if (finished || record_count == BOOT_PROFILE_RECORDS) {
+    return;
+  }
+  boot_record_t* r = &records[record_count++];
+  r->phase = (uint8_t)phase;
+  r->cycles = (now - last_stamp) & CPU_CYCLES_MASK;
+  // the first phase ran on the reset clock, which is still selected here
+  r->hz = phase_hz ? phase_hz : CLOCK_GetCoreSysClkFreq();
+  // hz in 1/256 MHz, so the 24 bit cycle count still fits after the shift
+  r->us = (r->cycles << 8) / (r->hz / 3906U);
+
+  phase_hz = CLOCK_GetCoreSysClkFreq();
+  finished = (phase == BOOT_PHASE_FIRST_FRAME);
+  last_stamp = now;
+}
+#endif
+
+// see .h for more details
+const boot_record_t* boot_profile_get(uint32_t* count) {
+  *count = record_count;
+  return records;
+}
+
+// see .h for more details
+const char* boot_phase_name(uint32_t phase) {
+  static const char* const names[BOOT_PHASES] = {
+    "reset", "pins", "clocks", "console", "analog", "adc_wait", "touch",
+    "shell", "standby", "capture_log", "selftest", "first_frame"
+  };
+  return (phase < BOOT_PHASES) ? names[phase] : "?";
+}
+
+// see .h for more details
+void boot_clock_start(void) {
+  const osc_config_t* osc = &oscConfig_BOARD_BootClockRUN;
+  const mcg_pll_config_t* pll = &mcgConfig_BOARD_BootClockRUN.pll0Config;
+
+  // CLOCK_InitOsc0() without the OSCINIT0 wait, 3-8 MHz crystals are the high range
+  OSC_SetCapLoad(OSC0, osc->capLoad);
+  OSC_SetExtRefClkConfig(OSC0, &osc->oscerConfig);
+  MCG->C2 = (MCG->C2 & ~(MCG_C2_EREFS0_MASK | MCG_C2_HGO0_MASK | MCG_C2_RANGE0_MASK))
+          | MCG_C2_RANGE0((osc->freq > 8000000U) ? 2U : 1U) | (uint8_t)osc->workMode;
+
+  // PLLCLKEN0 runs the PLL while PLLS still selects the FLL, it locks as
+  // soon as the crystal is up (reference OSCCLK / (PRDIV+1), 2-4 MHz)
+  MCG->C5 = MCG_C5_PRDIV0(pll->prdiv);
+  MCG->C6 = (MCG->C6 & ~MCG_C6_VDIV0_MASK) | MCG_C6_VDIV0(pll->vdiv);
+  MCG->C5 |= MCG_C5_PLLCLKEN0_MASK;
+}
+
+// see .h for more details
+void boot_clock_finish(void) {
+  const mcg_config_t* mcg = &mcgConfig_BOARD_BootClockRUN;
+
+  // both waits on the FLL at full speed, the safe dividers would halve it
+  while (!(MCG->S & MCG_S_OSCINIT0_MASK)) {;}
+  while (!(MCG->S & MCG_S_LOCK0_MASK)) {;}
+  CLOCK_SetXtal0Freq(oscConfig_BOARD_BootClockRUN.freq);
+  CLOCK_SetSimSafeDivs();
+
+  // FBE: the crystal drives MCGOUTCLK, the FLL reference moves to it through FRDIV
+  MCG->C2 &= ~MCG_C2_LP_MASK;
+  MCG->C1 = (MCG->C1 & ~(MCG_C1_CLKS_MASK | MCG_C1_IREFS_MASK | MCG_C1_FRDIV_MASK))
+          | MCG_C1_CLKS(kMCG_ClkOutSrcExternal) | MCG_C1_FRDIV(mcg->frdiv);
+  while ((MCG->S & (MCG_S_IREFST_MASK | MCG_S_CLKST_MASK)) != MCG_S_CLKST(MCG_CLKST_EXTERNAL)) {;}
+
+  // PBE, the PLL is already locked
+  MCG->C6 |= MCG_C6_PLLS_MASK;
+  while (!(MCG->S & MCG_S_PLLST_MASK)) {;}
+  while (!(MCG->S & MCG_S_LOCK0_MASK)) {;}
+
+  // PEE
+  MCG->C1 = (MCG->C1 & ~MCG_C1_CLKS_MASK) | MCG_C1_CLKS(kMCG_ClkOutSrcOut);
+  while ((MCG->S & MCG_S_CLKST_MASK) != MCG_S_CLKST(MCG_CLKST_PLL)) {;}
+
+  // the rest as in BOARD_BootClockRUN()
+  CLOCK_SetInternalRefClkConfig(mcg->irclkEnableMode, mcg->ircs, mcg->fcrdiv);
+  CLOCK_SetSimConfig(&simConfig_BOARD_BootClockRUN);
+  SystemCoreClock = BOARD_BOOTCLOCKRUN_CORE_CLOCK;
+}
@@ -0,0 +1,124 @@
+/*
+ * @file boot_profile.h
+ *
+ * @brief	Reset-to-first-frame timing and the BOOT_FAST_START bring-up
+ *
+ * boot_profile_start() runs in ResetISR before .data/.bss are set up and
+ * starts SysTick from zero (cpu_cycles_init() then leaves it running).
+ * main() calls boot_profile_mark() at the end of every boot phase. It keeps
+ * the cycles since the previous mark and the core clock the phase started
+ * at, so the shell (`boot`) can print each phase in microseconds. Marks are
+ * stored in the order they happen, which differs between the two boot paths.
+ * A single phase has to be shorter than the SysTick wrap (~349 ms at 48 MHz,
+ * ~800 ms on the FLL).
+ *
+ * The SDK clock bring-up (BOARD_BootClockRUN) waits in FEI for the crystal
+ * and then in FBE, where the core runs at 8 MHz, for the PLL lock. Its
+ * cycles are converted at the FLL rate, so the normal path's clocks phase
+ * reads shorter than it is.
+ *
+ * BOOT_FAST_START changes the order so the slow hardware waits overlap:
+ * 	- boot_clock_start() in ResetISR starts the crystal and the PLL
+ * 	  (PLLCLKEN0) while the core stays on the FLL, so they lock during
+ * 	  .data/.bss init and the pin setup. boot_clock_finish() waits for
+ * 	  the lock, still at the FLL rate, then steps FBE -> PBE -> PEE.
+ * 	- the ADC calibration is started (adc_cal_boot_start()) before the
+ * 	  console, LEDs and TSI are set up and only waited for afterwards
+ * 	- the TSI takes its baselines from the first interrupt driven sweep
+ * 	  instead of blocking scans
+ * 	- sampling starts as soon as the calibration is done. The shell,
+ * 	  standby, capture log, TPM1 and the self-test run while the first
+ * 	  block fills.
+ *
+ * Build options:
+ * 	BOOT_FAST_START       the overlapped bring-up above
+ * 	BOOT_PROFILE_DISABLE  no phase marks, SysTick starts in cpu_cycles_init()
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _BOOT_PROFILE_H_
+#define _BOOT_PROFILE_H_
+
+#include <stdint.h>
+
+// boot_phase_t, what ran since the previous mark
+typedef enum {
+  BOOT_PHASE_RESET = 0,     // ResetISR after SystemInit: .data/.bss copy, stack paint
+  BOOT_PHASE_PINS,          // BOARD_InitBootPins
+  BOOT_PHASE_CLOCKS,        // crystal start and PLL lock (fast start: what is left of it)
+  BOOT_PHASE_CONSOLE,       // BOARD_InitBootPeripherals and the debug UART
+  BOOT_PHASE_ANALOG,        // DMA0/TPM0/ADC0 and the calibration restore or run
+  BOOT_PHASE_ADC_WAIT,      // fast start: waiting for the calibration started earlier
+  BOOT_PHASE_TOUCH,         // LEDs and TSI, with the blocking baseline scans unless fast start
+  BOOT_PHASE_SHELL,
+  BOOT_PHASE_STANDBY,
+  BOOT_PHASE_CAPTURE_LOG,   // scan of the flash log for the write position
+  BOOT_PHASE_SELFTEST,      // test_dsp (DSP_UNIT_TESTS) and dsp_selftest
+  BOOT_PHASE_FIRST_FRAME,   // rest of the wait for the first 512 sample block
+  BOOT_PHASES
+} boot_phase_t;
+
+#define BOOT_PROFILE_RECORDS (BOOT_PHASES)
+
+typedef struct {
+  uint8_t phase;            // boot_phase_t
+  uint32_t cycles;          // core cycles since the previous mark
+  uint32_t hz;              // core clock when the phase began
+  uint32_t us;              // cycles at hz
+} boot_record_t;
+
+/* @brief   Starts SysTick from zero, called by ResetISR before .data/.bss
+ *          init, so it must not touch RAM variables
+ *
+ * @param   none
+ * @return  none
+ */
+void boot_profile_start(void);
+
+#if defined(BOOT_PROFILE_DISABLE)
+#define boot_profile_mark(phase) ((void)0)
+#else
+/* @brief   Ends a boot phase, the next one starts now. Marks after
+ *          BOOT_PHASE_FIRST_FRAME are ignored.
+ *
+ * @param   phase, the phase that just finished
+ * @return  none
+ */
+void boot_profile_mark(boot_phase_t phase);
+#endif
+
+/* @brief   The recorded phases in boot order
+ *
+ * @param   count, set to the number of records
+ * @return  the records, valid until the next reset
+ */
+const boot_record_t* boot_profile_get(uint32_t* count);
+
+/* @brief   Name of a phase for printing
+ *
+ * @param   phase, boot_phase_t
+ * @return  short lower case name
+ */
+const char* boot_phase_name(uint32_t phase);
+
+/* @brief   Starts the crystal and the PLL without waiting, the core stays on
+ *          the FLL. Called by ResetISR with BOOT_FAST_START, so it must not
+ *          touch RAM variables.
+ *
+ * @param   none
+ * @return  none
+ */
+void boot_clock_start(void);
+
+/* @brief   Waits for the crystal and PLL lock and switches to PEE with the
+ *          BOARD_BootClockRUN settings, in place of BOARD_InitBootClocks()
+ *
+ * @param   none
+ * @return  none
+ */
+void boot_clock_finish(void);
+
+#endif // _BOOT_PROFILE_H_
@@ -0,0 +1,442 @@
+/*
+ * @file capture_log.c
+ *
+ * @brief	Circular flash capture log, see capture_log.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <fsl_debug_console.h>
+#include <analog_peripherals.h>
+#include <flash_store.h>
+#include <crc16.h>
+#include <cpu_cycles.h>
+#include <sample_codec.h>
+#include <telemetry.h>
+#include <capture_log.h>
+
+#define CLOG_MAGIC          (0x31474C43U)   // "CLG1"
+#define SECTOR_HEADER_BYTES (12U)
+#define RECORD_HEADER_BYTES (8U)
+#define NUM_SECTORS         ((CAPTURE_LOG_END - CAPTURE_LOG_START) / FLASH_STORE_SECTOR_SIZE)
+#define MAX_PAYLOAD         (FLASH_STORE_SECTOR_SIZE - SECTOR_HEADER_BYTES - RECORD_HEADER_BYTES)
+
+// set in len when a record was given up half written, readers step over it
+#define RECORD_ABANDONED    (0x8000U)
+#define RECORD_LEN_MASK     (0x7FFFU)
+
+// frames go out in chunks that pack 7 to a sector (64 raw samples), chunk index in the kind's high nibble
+#define CHUNK_BYTES         (128U)
+
+#if (CAPTURE_LOG_START % FLASH_STORE_SECTOR_SIZE) || (CAPTURE_LOG_END % FLASH_STORE_SECTOR_SIZE)
+#error "CAPTURE_LOG_START and CAPTURE_LOG_END must be sector aligned"
+#endif
+#if (CAPTURE_EVENT_QUEUE & (CAPTURE_EVENT_QUEUE - 1)) != 0
+#error "CAPTURE_EVENT_QUEUE must be a power of two"
+#endif
+#if (CAPTURE_LOG_END <= CAPTURE_LOG_START + FLASH_STORE_SECTOR_SIZE)
+#error "the capture log needs at least two sectors"
+#endif
+
+// end of the firmware image in flash, from the managed linker script
+extern uint32_t _image_end;
+
+typedef struct {
+  uint16_t bin;
+  int16_t magnitude;
+  uint32_t frame;
+} capture_pending_event_t;
+
+// the record being programmed
+typedef struct {
+  bool active;
+  uint8_t kind;
+  uint32_t frame;
+  const uint8_t* src;       // payload, word aligned
+  uint32_t len;             // payload bytes, a multiple of 4
+  uint32_t addr;            // record start in flash, 0 until space is reserved
+  uint32_t done;            // payload bytes programmed, word1 is programmed first
+  bool header1_done;
+  uint16_t crc;
+} capture_job_t;
+
+static bool log_ok;
+static uint32_t head_sector;        // sector being written
+static uint32_t head_seq;           // its seq, 0 when the log is empty
+static uint32_t write_addr;         // next free byte in the head sector
+static uint32_t open_step;          // 0 idle, 1 erased, 2..4 header words being written
+static uint32_t valid_sectors;      // stamped sectors, the head included
+static capture_stats_t stats;
+
+static capture_pending_event_t events[CAPTURE_EVENT_QUEUE];
+static uint32_t event_head, event_tail;
+static uint32_t event_payload;      // payload word of the event job
+
+static capture_job_t job;
+static uint32_t abandon_addr;       // record to mark abandoned by capture_log_service(), 0 none
+static uint32_t abandon_word;       // its length word with RECORD_ABANDONED
+static const uint8_t* frame_data;   // the block, encoded in place
+static uint8_t frame_kind;
+static uint32_t frame_number;
+static uint32_t frame_bytes_left;
+static uint32_t frame_next_chunk;
+static adpcm_state_t adpcm_state;
+
+static uint32_t sector_addr(uint32_t sector) {
+  return CAPTURE_LOG_START + sector * FLASH_STORE_SECTOR_SIZE;
+}
+
+static bool sector_valid(uint32_t sector, uint32_t* seq) {
+  uint32_t a = sector_addr(sector);
+  uint32_t s = flash_store_read_word(a + 4);
+  if (flash_store_read_word(a) != CLOG_MAGIC || flash_store_read_word(a + 8) != ~s) {
+    return false;
+  }
+  *seq = s;
+  return true;
+}
+
+static uint32_t record_bytes(uint32_t len) {
+  return RECORD_HEADER_BYTES + ((len + 3U) & ~3U);
+}
+
+// walks the records of a sector, returns the first free byte or the sector end if damaged
+static uint32_t sector_end_of_records(uint32_t sector) {
+  uint32_t addr = sector_addr(sector) + SECTOR_HEADER_BYTES;
+  uint32_t end = sector_addr(sector) + FLASH_STORE_SECTOR_SIZE;
+
+  while (addr + RECORD_HEADER_BYTES <= end) {
+    uint32_t w0 = flash_store_read_word(addr);
+    if (w0 == FLASH_STORE_ERASED) {
+      // a reset mid-record leaves programmed words past the last header
+      return flash_store_is_blank(addr, end - addr) ? addr : end;
+    }
+    uint32_t len = w0 & RECORD_LEN_MASK;
+    if (len > MAX_PAYLOAD) {
+      return end;
+    }
+    addr += record_bytes(len);
+  }
+  return end;
+}
+
+// see .h for more details
+bool capture_log_init() {
+  uint32_t seq, valid = 0;
+
+  log_ok = false;
+  if ((uint32_t)&_image_end > CAPTURE_LOG_START) {
+    return false;
+  }
+  if (!flash_store_init()) {
+    return false;
+  }
+
+  head_seq = 0;
+  head_sector = NUM_SECTORS - 1;
+  for (uint32_t i = 0; i < NUM_SECTORS; i++) {
+    if (sector_valid(i, &seq)) {
+      valid++;
+      if (head_seq == 0 || (int32_t)(seq - head_seq) > 0) {
+        head_seq = seq;
+        head_sector = i;
+      }
+    }
+  }
+
+  valid_sectors = valid;
+  stats.size_bytes = NUM_SECTORS * FLASH_STORE_SECTOR_SIZE;
+  if (head_seq == 0) {
+    // empty log, the first record opens sector 0
+    write_addr = sector_addr(head_sector) + FLASH_STORE_SECTOR_SIZE;
+  } else {
+    write_addr = sector_end_of_records(head_sector);
+    // once per boot, the divide is fine here
+    stats.laps = head_seq / NUM_SECTORS;
+  }
+  log_ok = true;
+  return true;
+}
+
+// see .h for more details
+void capture_event(uint32_t frame, uint16_t bin, int16_t magnitude) {
+  if (!log_ok) {
+    return;
+  }
+  if (event_head - event_tail == CAPTURE_EVENT_QUEUE) {
+    stats.dropped++;
+    return;
+  }
+  capture_pending_event_t* e = &events[event_head & (CAPTURE_EVENT_QUEUE - 1)];
+  e->frame = frame;
+  e->bin = bin;
+  e->magnitude = magnitude;
+  event_head++;
+}
+
+// see .h for more details
+bool capture_frame(uint32_t frame, uint16_t* samples, uint32_t nsamples, codec_t codec) {
+  uint32_t bytes = nsamples << 1;
+
+  if (!log_ok || frame_bytes_left != 0 || nsamples < 2) {
+    return false;
+  }
+  // an ADPCM block's size is known up front, a Rice block is budgeted as raw
+  uint32_t guard = (codec == CODEC_ADPCM) ? ((CAPTURE_FRAME_GUARD_SAMPLES * ADPCM_BYTES(nsamples)) >> 10) :
+                   CAPTURE_FRAME_GUARD_SAMPLES;
+  if (analog_samples_remaining() < guard + CAPTURE_GUARD_SAMPLES) {
+    stats.skipped_frames++;
+    return false;
+  }
+
+  uint32_t start = cpu_cycles_now();
+  if (codec == CODEC_ADPCM) {
+    bytes = adpcm_encode(samples, nsamples, &adpcm_state);
+    frame_kind = CAPTURE_KIND_ADPCM;
+  } else if (codec == CODEC_RICE) {
+    bytes = rice_encode(samples, nsamples);
+    frame_kind = CAPTURE_KIND_RICE;
+  } else {
+    frame_kind = CAPTURE_KIND_SAMPLES;
+  }
+  stats.encode_cycles = cpu_cycles_since(start);
+  if (stats.encode_cycles > stats.encode_cycles_max) {
+    stats.encode_cycles_max = stats.encode_cycles;
+  }
+  stats.frame_bytes = bytes;
+
+  frame_data = (const uint8_t*)samples;
+  frame_number = frame;
+  // records are whole words, the padding stays inside the ADC buffer
+  frame_bytes_left = (bytes + 3U) & ~3U;
+  frame_next_chunk = 0;
+  return true;
+}
+
+// see .h for more details
+void capture_log_release_frame() {
+  bool raw_job = job.active && job.kind != CAPTURE_KIND_PITCH;
+
+  if (!raw_job && frame_bytes_left == 0) {
+    return;
+  }
+  if (raw_job && job.addr != 0) {
+    // the space is reserved: capture_log_service() closes it, behind its guards,
+    // so readers step over it to later records. It goes before any other word,
+    // so one pending marker is enough
+    abandon_addr = job.addr;
+    abandon_word = job.len | RECORD_ABANDONED;
+  }
+  job.active = job.active && !raw_job;
+  stats.dropped++;
+  frame_bytes_left = 0;
+  frame_data = NULL;
+}
+
+// erase and stamp the sector after the head, one flash operation per call
+static bool open_next_sector() {
+  uint32_t next = (head_sector + 1 == NUM_SECTORS) ? 0 : head_sector + 1;
+  uint32_t a = sector_addr(next);
+  uint32_t seq = head_seq + 1;
+
+  switch (open_step) {
+    case 0:
+      if (!flash_store_is_blank(a, FLASH_STORE_SECTOR_SIZE)) {
+        // interrupts are masked for the erase, with ANALOG_OVERSAMPLE the
+        // slack never reaches this and only blank sectors are opened
+        if (analog_irq_slack() < CAPTURE_ERASE_GUARD_SAMPLES) {
+          return false;
+        }
+        uint32_t old_seq;
+        if (sector_valid(next, &old_seq)) {
+          valid_sectors--;
+        }
+        flash_store_erase_sector(a);
+        stats.erases++;
+      }
+      open_step = 1;
+      return false;
+    case 1:
+      flash_store_program_word(a + 4, seq);
+      open_step = 2;
+      return false;
+    case 2:
+      flash_store_program_word(a + 8, ~seq);
+      open_step = 3;
+      return false;
+    default:
+      // the magic goes last: the sector only counts once it is fully stamped
+      flash_store_program_word(a, CLOG_MAGIC);
+      open_step = 0;
+      head_sector = next;
+      head_seq = seq;
+      write_addr = a + SECTOR_HEADER_BYTES;
+      valid_sectors++;
+      if (next == 0 && seq > 1) {
+        stats.laps++;
+      }
+      return true;
+  }
+}
+
+// picks the next record to program, frame chunks before events
+static bool next_job() {
+  if (frame_bytes_left != 0) {
+    job.kind = (uint8_t)(frame_kind | (frame_next_chunk << 4));
+    job.frame = frame_number;
+    job.src = frame_data + frame_next_chunk * CHUNK_BYTES;
+    job.len = (frame_bytes_left < CHUNK_BYTES) ? frame_bytes_left : CHUNK_BYTES;
+    frame_next_chunk++;
+    frame_bytes_left -= job.len;
+  } else if (event_tail != event_head) {
+    capture_pending_event_t* e = &events[event_tail & (CAPTURE_EVENT_QUEUE - 1)];
+    event_payload = (uint32_t)e->bin | ((uint32_t)(uint16_t)e->magnitude << 16);
+    job.kind = CAPTURE_KIND_PITCH;
+    job.frame = e->frame;
+    job.src = (const uint8_t*)&event_payload;
+    job.len = sizeof(event_payload);
+    event_tail++;
+  } else {
+    return false;
+  }
+  job.active = true;
+  job.addr = 0;
+  job.done = 0;
+  job.header1_done = false;
+  return true;
+}
+
+// see .h for more details
+void capture_log_service() {
+  if (!log_ok) {
+    return;
+  }
+
+  // each word masks interrupts, DMA0_IRQHandler must still be on time
+  while (analog_irq_slack() > CAPTURE_GUARD_SAMPLES) {
+    if (abandon_addr != 0) {
+      flash_store_program_word(abandon_addr, abandon_word);
+      abandon_addr = 0;
+      continue;
+    }
+    if (!job.active && !next_job()) {
+      return;
+    }
+
+    if (job.addr == 0) {
+      // reserve space, opening a new sector when this one is full
+      if (write_addr + record_bytes(job.len) > sector_addr(head_sector) + FLASH_STORE_SECTOR_SIZE ||
+          head_seq == 0) {
+        if (!open_next_sector()) {
+          if (open_step == 0) {
+            // not enough time left for an erase, try after the next frame
+            return;
+          }
+          continue;
+        }
+      }
+      job.addr = write_addr;
+      write_addr += record_bytes(job.len);
+      continue;
+    }
+
+    if (!job.header1_done) {
+      uint32_t w1 = (uint32_t)job.kind | (job.frame << 8);
+      job.crc = crc16_ccitt(CRC16_INIT, &w1, sizeof(w1));
+      flash_store_program_word(job.addr + 4, w1);
+      job.header1_done = true;
+      continue;
+    }
+
+    if (job.done < job.len) {
+      uint32_t w = *(const uint32_t*)(job.src + job.done);
+      job.crc = crc16_ccitt(job.crc, &w, sizeof(w));
+      flash_store_program_word(job.addr + RECORD_HEADER_BYTES + job.done, w);
+      job.done += 4;
+      continue;
+    }
+
+    // commit: the length/CRC word makes the record visible
+    flash_store_program_word(job.addr, job.len | ((uint32_t)job.crc << 16));
+    job.active = false;
+    stats.records++;
+  }
+}
+
+// see .h for more details
+uint32_t capture_log_dump() {
+  uint32_t sent = 0, seq;
+
+  if (!log_ok || head_seq == 0) {
+    return 0;
+  }
+
+  // every record must reach the host, so wait for ring space instead of dropping
+  DbgConsole_SetTxOverflowPolicy(kDebugConsole_TxOverflowBlock);
+
+  // ring order after the head is oldest to newest
+  for (uint32_t k = 1; k <= NUM_SECTORS; k++) {
+    uint32_t sector = head_sector + k;
+    if (sector >= NUM_SECTORS) {
+      sector -= NUM_SECTORS;
+    }
+    if (!sector_valid(sector, &seq)) {
+      continue;
+    }
+    uint32_t addr = sector_addr(sector) + SECTOR_HEADER_BYTES;
+    uint32_t end = sector_end_of_records(sector);
+    while (addr < end) {
+      uint32_t w0 = flash_store_read_word(addr);
+      uint32_t w1 = flash_store_read_word(addr + 4);
+      uint32_t len = w0 & RECORD_LEN_MASK;
+      const uint8_t* payload = (const uint8_t*)(addr + RECORD_HEADER_BYTES);
+      uint16_t crc = crc16_ccitt(CRC16_INIT, &w1, sizeof(w1));
+      crc = crc16_ccitt(crc, payload, len);
+      if (!(w0 & RECORD_ABANDONED) && crc == (uint16_t)(w0 >> 16)) {
+        telem_send_capture(w1 >> 8, (uint8_t)w1, payload, (uint16_t)len);
+        sent++;
+      }
+      addr += record_bytes(len);
+    }
+  }
+
+  DbgConsole_Flush();
+  DbgConsole_SetTxOverflowPolicy(DEBUG_CONSOLE_TX_OVERFLOW);
+  return sent;
+}
+
+// see .h for more details
+void capture_log_erase() {
+  if (!flash_store_init()) {
+    return;
+  }
+  job.active = false;
+  abandon_addr = 0;
+  frame_bytes_left = 0;
+  event_tail = event_head;
+  open_step = 0;
+  // the erases mask interrupts for tens of ms, sampling restarts afterwards
+  // instead of leaving a gap inside a frame
+  analog_stop();
+  for (uint32_t i = 0; i < NUM_SECTORS; i++) {
+    if (!flash_store_is_blank(sector_addr(i), FLASH_STORE_SECTOR_SIZE)) {
+      flash_store_erase_sector(sector_addr(i));
+      stats.erases++;
+    }
+  }
+  analog_restart();
+  capture_log_init();
+}
+
+// see .h for more details
+void capture_log_get_stats(capture_stats_t* out) {
+  *out = stats;
+  // full sectors count whole, their unused tails cannot take records anyway
+  out->used_bytes = (valid_sectors == 0) ? 0 :
+      (valid_sectors - 1) * FLASH_STORE_SECTOR_SIZE + (write_addr - sector_addr(head_sector));
+}
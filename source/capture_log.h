@@ -0,0 +1,173 @@
+/*
+ * @file capture_log.h
+ *
+ * @brief	Circular capture log in the program flash above the firmware image
+ *
+ * Pitch events and ADC frames (raw or encoded) are appended as records to 1 KB sectors
+ * between CAPTURE_LOG_START and CAPTURE_LOG_END. When the newest sector is
+ * full the oldest one is erased and reused, so every sector is erased once per
+ * lap of the log (wear levelling by rotation).
+ *
+ * sector:  magic "CLG1" (4) | seq (4) | ~seq (4) | records...
+ * record:  len (2) | crc (2) | kind (1) | frame (3) | payload, padded to 4 bytes
+ * 	crc is CRC-16/CCITT over kind, frame and payload. An ADC block is stored
+ * 	as records of up to 128 bytes with the chunk index in the high nibble of
+ * 	kind: 8 for a raw block, 3 for an ADPCM one (sample_codec.h).
+ *
+ * Power-fail safety: a sector counts only once its three header words agree,
+ * and seq orders the sectors after a reset. Inside a record the first word
+ * (len/crc) is programmed last. A record interrupted by a reset reads as
+ * erased (end of log). One abandoned by the scheduler is closed with bit 15 of
+ * len set, and readers step over it by its length. When capture_log_init() finds
+ * programmed words after the last record, it closes that sector and continues
+ * in the next one.
+ *
+ * Scheduling: capture_event()/capture_frame() only queue work.
+ * capture_log_service() programs words from main()'s idle loop, and only while
+ * analog_irq_slack() has more than CAPTURE_GUARD_SAMPLES samples to go.
+ * Interrupts are held off for one word at a time (<= 145 us), and a sector erase
+ * only starts with CAPTURE_ERASE_GUARD_SAMPLES to go, so frames are never late.
+ * With ANALOG_OVERSAMPLE the slack is what is left of a 64-sample DMA block, so
+ * words still go in between blocks but no erase ever fits. The log then fills
+ * the blank sectors and drops what comes after; capture_log_erase() stops
+ * sampling while it blanks the log.
+ * A frame is encoded in place in the ping-pong buffer and programmed straight
+ * from it. It must finish before main() takes the next block, otherwise it is
+ * abandoned (capture_log_release_frame()). ADPCM cuts a block from 1 KB to
+ * 260 bytes, so about four times as many frames fit in the log and in the
+ * time left per frame.
+ *
+ * Build options:
+ * 	CAPTURE_LOG_START    first byte of the log (default 0x18000, must be above _image_end)
+ * 	CAPTURE_LOG_END      end of the log (default 0x1FC00, the last sector holds the ADC calibration, adc_cal.h)
+ * 	CAPTURE_EVENT_QUEUE  events waiting to be programmed (default 16)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _CAPTURE_LOG_H_
+#define _CAPTURE_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sample_codec.h>
+
+#ifndef CAPTURE_LOG_START
+#define CAPTURE_LOG_START (0x18000U)
+#endif
+
+#ifndef CAPTURE_LOG_END
+#define CAPTURE_LOG_END (0x1FC00U)
+#endif
+
+#ifndef CAPTURE_EVENT_QUEUE
+#define CAPTURE_EVENT_QUEUE (16)
+#endif
+
+// ~1 ms of samples left before the next block: enough for one word program
+#define CAPTURE_GUARD_SAMPLES (10U)
+// ~40 ms of samples left: covers a typical 14 ms sector erase with margin
+#define CAPTURE_ERASE_GUARD_SAMPLES (330U)
+// 256 words at ~100 us each, a raw frame is not started with less time left
+#define CAPTURE_FRAME_GUARD_SAMPLES (220U)
+
+// what main() records
+typedef enum {
+  CAPTURE_OFF    = 0,
+  CAPTURE_EVENTS = 1,   // one record per reported pitch
+  CAPTURE_FRAMES = 2    // ADC blocks when there is time, plus events
+} capture_mode_t;
+
+// record kinds
+typedef enum {
+  CAPTURE_KIND_PITCH   = 1,   // bin (2) | magnitude (2)
+  CAPTURE_KIND_SAMPLES = 2,   // raw uint16 ADC samples
+  CAPTURE_KIND_ADPCM   = 3,   // adpcm_encode() block
+  CAPTURE_KIND_RICE    = 4    // rice_encode() block
+} capture_kind_t;
+
+typedef struct {
+  uint32_t records;         // records committed since reset
+  uint32_t dropped;         // events lost to a full queue or frames abandoned
+  uint32_t skipped_frames;  // frames not started for lack of time
+  uint32_t erases;          // sector erases since reset
+  uint32_t laps;            // times the log has wrapped, from the sector seq
+  uint32_t used_bytes;      // bytes of the log holding records
+  uint32_t size_bytes;      // log size
+  uint32_t frame_bytes;     // stored size of the last frame
+  uint32_t encode_cycles;   // core cycles encoding the last frame
+  uint32_t encode_cycles_max;
+} capture_stats_t;
+
+/* @brief   Mounts the log: finds the newest sector and the end of its records
+ *
+ * @param   none
+ * @return  false if the flash driver failed or the log overlaps the image
+ */
+bool capture_log_init();
+
+/* @brief   Queues a pitch event
+ *
+ * @param   frame, frame number
+ *          bin, reported bin
+ *          magnitude, its power
+ * @return  none
+ */
+void capture_event(uint32_t frame, uint16_t bin, int16_t magnitude);
+
+/* @brief   Encodes an ADC block in place and starts recording it if there is
+ *          time before the next one
+ *
+ * @param   frame, frame number
+ *          samples, get_samples() buffer, overwritten by the encoder; it must
+ *          stay valid until capture_log_release_frame()
+ *          nsamples, samples in the block
+ *          codec, CODEC_RAW leaves the samples as they are
+ * @return  true if the frame was accepted
+ */
+bool capture_frame(uint32_t frame, uint16_t* samples, uint32_t nsamples, codec_t codec);
+
+/* @brief   Gives up a frame still being programmed, call before get_samples()
+ *
+ * Programs nothing itself: the abandoned marker of a record already in flash
+ * is left to capture_log_service() and its guards.
+ *
+ * @param   none
+ * @return  none
+ */
+void capture_log_release_frame();
+
+/* @brief   Programs queued records within the time left before the next ADC block
+ *
+ * @param   none
+ * @return  none
+ */
+void capture_log_service();
+
+/* @brief   Sends every valid record, oldest first, as TELEM_CAPTURE frames
+ *
+ * Blocks until the console has taken everything; frames that complete in the
+ * meantime are skipped.
+ *
+ * @param   none
+ * @return  records sent
+ */
+uint32_t capture_log_dump();
+
+/* @brief   Erases the whole log, sampling stops meanwhile (analog_stop())
+ *
+ * @param   none
+ * @return  none
+ */
+void capture_log_erase();
+
+/* @brief   Log counters
+ *
+ * @param   stats, filled in
+ * @return  none
+ */
+void capture_log_get_stats(capture_stats_t* stats);
+
+#endif // _CAPTURE_LOG_H_
@@ -0,0 +1,23 @@
+/*
+ * @file cpu_cycles.c
+ *
+ * @brief	SysTick cycle stamps, see cpu_cycles.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <cpu_cycles.h>
+
+// see .h for more details
+void cpu_cycles_init() {
+  // already free running since ResetISR (boot_profile_start()), keep the stamps continuous
+  if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) && SysTick->LOAD == CPU_CYCLES_MASK) {
+    return;
+  }
+  SysTick->CTRL = 0;
+  SysTick->LOAD = CPU_CYCLES_MASK;
+  SysTick->VAL = 0;
+  SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
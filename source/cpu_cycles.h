@@ -0,0 +1,50 @@
+/*
+ * @file cpu_cycles.h
+ *
+ * @brief	Core clock cycle stamps from SysTick for ISR and phase timing
+ *
+ * The Cortex-M0+ has no DWT cycle counter, so SysTick runs free at the core
+ * clock with no interrupt. It is 24 bits wide and counts down; cpu_cycles_now()
+ * flips it to count up. At 48 MHz it wraps every ~349 ms, so only intervals
+ * shorter than that can be measured, which covers any ISR or frame.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _CPU_CYCLES_H_
+#define _CPU_CYCLES_H_
+
+#include <stdint.h>
+#include "MKL25Z4.h"
+
+#define CPU_CYCLES_MASK (0x00FFFFFFU)
+
+/* @brief   Starts SysTick free running from the core clock, interrupt off.
+ *          Does nothing if boot_profile_start() already did.
+ *
+ * @param   none
+ * @return  none
+ */
+void cpu_cycles_init();
+
+/* @brief   Current cycle stamp, counts up and wraps at 2^24
+ *
+ * @param   none
+ * @return  stamp to pass to cpu_cycles_since()
+ */
+static inline uint32_t cpu_cycles_now() {
+  return ~SysTick->VAL & CPU_CYCLES_MASK;
+}
+
+/* @brief   Cycles elapsed since a stamp, correct across one wrap
+ *
+ * @param   start, earlier cpu_cycles_now() result
+ * @return  core clock cycles
+ */
+static inline uint32_t cpu_cycles_since(uint32_t start) {
+  return (cpu_cycles_now() - start) & CPU_CYCLES_MASK;
+}
+
+#endif // _CPU_CYCLES_H_
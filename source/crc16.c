@@ -0,0 +1,31 @@
+/*
+ * @file crc16.c
+ *
+ * @brief	CRC-16/CCITT-FALSE, see crc16.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <crc16.h>
+
+// CRC of each 4 bit value, shifted into the top nibble
+static const uint16_t crc16_nibble[16] = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+// see .h for more details
+uint16_t crc16_ccitt(uint16_t crc, const void* data, uint32_t len) {
+
+  const uint8_t* p = (const uint8_t*)data;
+
+  while (len--) {
+    crc = (uint16_t)((crc << 4) ^ crc16_nibble[(crc >> 12) ^ (*p >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ crc16_nibble[(crc >> 12) ^ (*p & 0x0F)]);
+    p++;
+  }
+  return crc;
+}
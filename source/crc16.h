@@ -0,0 +1,29 @@
+/*
+ * @file crc16.h
+ *
+ * @brief	CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) for self-tests and framing
+ *
+ * Nibble table driven: 32 bytes of flash and no divides, which suits the M0+.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _CRC16_H_
+#define _CRC16_H_
+
+#include <stdint.h>
+
+#define CRC16_INIT (0xFFFFU)
+
+/* @brief   Continues a CRC-16/CCITT over len bytes
+ *
+ * @param   crc,  CRC16_INIT to start, or the result of a previous call
+ *          data, bytes to add
+ *          len,  number of bytes
+ * @return  updated CRC
+ */
+uint16_t crc16_ccitt(uint16_t crc, const void* data, uint32_t len);
+
+#endif // _CRC16_H_
@@ -0,0 +1,74 @@
+/*
+ * @file dsp_bench.c
+ *
+ * @brief	FFT pipeline cycle benchmark, see dsp_bench.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "MKL25Z4.h"
+#include <cpu_cycles.h>
+#include <dsp_fft.h>
+#include <dsp_bench.h>
+#include "arm_math.h"
+#include "arm_common_tables.h"
+
+#define DSP_BENCH_NSAMPLES (512)
+#define SRAM_START         (0x1FFFF000U)
+#define SRAM_END           (0x20003000U)
+
+// cache off: no instruction or data caching, the controller cache disabled
+#define PLACR_CACHE_OFF (MCM_PLACR_DFCC_MASK | MCM_PLACR_DFCIC_MASK | MCM_PLACR_DFCDA_MASK)
+
+// one pass, the cache is cleared first so every pass starts cold
+static void dsp_bench_pass(const uint16_t* samples, uint32_t runs, uint32_t placr,
+                           dsp_bench_result_t* r) {
+  uint32_t total = 0;
+
+  MCM->PLACR = placr | MCM_PLACR_CFCC_MASK;
+  r->min = CPU_CYCLES_MASK;
+  r->max = 0;
+  for (uint32_t i = 0; i < runs; i++) {
+    uint32_t start = cpu_cycles_now();
+    int16_t* mags = dsp_fft_mag(samples, DSP_BENCH_NSAMPLES);
+    (void)dsp_fft_max_pitch(mags);
+    uint32_t cycles = cpu_cycles_since(start);
+
+    total += cycles;
+    if (cycles < r->min) r->min = cycles;
+    if (cycles > r->max) r->max = cycles;
+  }
+  r->avg = total / runs;
+}
+
+// see .h for more details
+bool dsp_bench_run(const uint16_t* samples, uint32_t runs, dsp_bench_result_t results[DSP_BENCH_MODES]) {
+  if (samples == NULL || runs == 0 || runs > DSP_BENCH_MAX_RUNS) {
+    return false;
+  }
+
+  uint32_t saved = MCM->PLACR & ~MCM_PLACR_CFCC_MASK;
+  uint32_t placr = saved & ~PLACR_CACHE_OFF;
+  dsp_bench_pass(samples, runs, placr, &results[DSP_BENCH_CACHE_ON]);
+  dsp_bench_pass(samples, runs, placr | PLACR_CACHE_OFF, &results[DSP_BENCH_CACHE_OFF]);
+  MCM->PLACR = saved | MCM_PLACR_CFCC_MASK;
+  return true;
+}
+
+// function or object address inside the SRAM region
+static bool dsp_bench_in_sram(const void* addr) {
+  uint32_t a = (uint32_t)addr;
+  return (a >= SRAM_START) && (a < SRAM_END);
+}
+
+// see .h for more details
+void dsp_bench_placement(dsp_bench_placement_t* placement) {
+  placement->fft_mag = dsp_bench_in_sram((const void*)dsp_fft_mag);
+  placement->cmsis = dsp_bench_in_sram((const void*)arm_cfft_q15);
+  placement->tables = dsp_bench_in_sram(twiddleCoef_256_q15);
+}
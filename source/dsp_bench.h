@@ -0,0 +1,65 @@
+/*
+ * @file dsp_bench.h
+ *
+ * @brief	Cycle benchmark of the FFT pipeline with the flash cache on and off
+ *
+ * Times dsp_fft_mag() plus dsp_fft_max_pitch() on a 512 sample block with
+ * cpu_cycles, once with the MCM flash controller cache enabled (reset state)
+ * and once with it disabled (MCM_PLACR DFCC/DFCIC/DFCDA). The cache is
+ * cleared before each pass and restored afterwards. Which memory the hot
+ * functions run from depends on the build (DSP_FFT_RAMFUNC and
+ * make DSP_RAMFUNC=1, see dsp_fft.h), so the A/B against flash execution is
+ * the same run on both builds. With the code in SRAM the cache off pass shows
+ * what is left on the flash bus (tables, veneers, the callers).
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _DSP_BENCH_H_
+#define _DSP_BENCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DSP_BENCH_MAX_RUNS (64)
+
+// dsp_bench_mode_t, MCM flash cache setting of a pass
+typedef enum {
+  DSP_BENCH_CACHE_ON = 0,
+  DSP_BENCH_CACHE_OFF,
+  DSP_BENCH_MODES
+} dsp_bench_mode_t;
+
+typedef struct {
+  uint32_t min;             // core cycles per frame
+  uint32_t max;
+  uint32_t avg;
+} dsp_bench_result_t;
+
+// what this build runs from SRAM
+typedef struct {
+  bool fft_mag;             // dsp_fft_mag(), DSP_FFT_RAMFUNC
+  bool cmsis;               // arm_cfft_q15() and the butterflies, make DSP_RAMFUNC=1
+  bool tables;              // twiddleCoef_256_q15, make DSP_RAMFUNC_TABLES=1
+} dsp_bench_placement_t;
+
+/* @brief   Runs both passes, sampling must be stopped (analog_stop()) so the
+ *          DMA does not share the bus
+ *
+ * @param   samples, 512 ADC samples
+ *          runs, frames per pass, 1 to DSP_BENCH_MAX_RUNS
+ *          results, one per dsp_bench_mode_t
+ * @return  false if samples is NULL or runs is out of range
+ */
+bool dsp_bench_run(const uint16_t* samples, uint32_t runs, dsp_bench_result_t results[DSP_BENCH_MODES]);
+
+/* @brief   Checks the addresses the linker gave the hot path
+ *
+ * @param   placement, filled in
+ * @return  none
+ */
+void dsp_bench_placement(dsp_bench_placement_t* placement);
+
+#endif // _DSP_BENCH_H_
@@ -13,6 +13,7 @@
  * https://community.nxp.com/t5/MCUXpresso-General-Knowledge/Using-CMSIS-DSP-with-MCUXpresso-SDK-and-IDE/ta-p/1129232
  */
 #include <dsp_fft.h>
+#include <tlog.h>
 #include <stdio.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -23,21 +24,57 @@
 #define MAXSAMPLES    	 (512)
 #define HARMONICS     	 (32)
 
-// Describe the major formants in the PDA
-#define FORMANT_G4    	 (1)
-#define FORMANT_G5	  	 (3)
-#define FORMANT_B5		 (5)
-#define FORMANT_D_SHARP6 (4)
-#define FORMANT_E_FLAT7  (9)
-#define FORMANT_G7		 (11)
-#define FORMANT_B7		 (14)
+// largest transform dsp_fft_mag() will accept, host builds raise this to sweep N
+#ifndef DSP_FFT_MAX_SAMPLES
+#define DSP_FFT_MAX_SAMPLES (MAXSAMPLES)
+#endif
+#define DSP_FFT_MIN_SAMPLES (64)
+
+// per-function .ramfunc.<name> sections go to SRAM with .data, see dsp_fft.h
+#if defined(DSP_FFT_RAMFUNC)
+#define DSP_RAMFUNC(name) __attribute__((section(".ramfunc." #name), noinline))
+#else
+#define DSP_RAMFUNC(name)
+#endif
+#if defined(DSP_FFT_RAMDATA)
+#define DSP_RAMDATA(name) __attribute__((section(".data." #name)))
+#else
+#define DSP_RAMDATA(name)
+#endif
 
 // define variables that are required for arm_fft
-static q15_t FFT_mag[MAXSAMPLES];
-static const int16_t hanning[MAXSAMPLES];
+static q15_t FFT_mag[DSP_FFT_MAX_SAMPLES];
+static const int16_t hanning[MAXSAMPLES] DSP_RAMDATA(hanning);
 
+// runtime tunables (command shell), defaults match the original constants
+static int search_bins = HARMONICS;
+static int16_t b5_threshold = HARMONICS * 2;
 
-uint16_t dsp_fft_max_pitch(int16_t* fft_mag)
+// see .h for more details
+void dsp_fft_set_search_bins(int bins) {
+  if (bins >= 2 && bins <= DSP_FFT_MAX_SAMPLES/2) {
+    search_bins = bins;
+  }
+}
+
+// see .h for more details
+int dsp_fft_search_bins() {
+  return search_bins;
+}
+
+// see .h for more details
+void dsp_fft_set_b5_threshold(int16_t threshold) {
+  b5_threshold = threshold;
+}
+
+// see .h for more details
+int16_t dsp_fft_b5_threshold() {
+  return b5_threshold;
+}
+
+// see .h for more details
+DSP_RAMFUNC(dsp_fft_peak_bin)
+uint16_t dsp_fft_peak_bin(const int16_t* fft_mag)
 {
 
   // error case
@@ -53,14 +90,27 @@ uint16_t dsp_fft_max_pitch(int16_t* fft_mag)
    * we are guaranteed to find some harmonic leakage in the first 32 bins as long as our
    * signal is above  2 * DC value
    */
-  for (i = 1; i <HARMONICS; ++i)
+  for (i = 1; i <search_bins; ++i)
   {
       if (fft_mag[bucket_peak] < fft_mag[i])
       bucket_peak=i;
   }
+return bucket_peak;
+}
+
+uint16_t dsp_fft_max_pitch(int16_t* fft_mag)
+{
+
+  // error case
+  if (fft_mag==NULL )  {
+    return -1;
+  }
+
+  uint16_t bucket_peak = dsp_fft_peak_bin(fft_mag);
 
   // special case for detecting B5 because too many fundamental frequency artifacts at 1000Hz
-  if((bucket_peak == 3) && (fft_mag[bucket_peak + 1] > HARMONICS * 2)){
+  // (b5_threshold 0 turns the correction off)
+  if((b5_threshold > 0) && (bucket_peak == 3) && (fft_mag[bucket_peak + 1] > b5_threshold)){
 	// choose the next ODD frequency
 	bucket_peak = 5;
   }
@@ -72,54 +122,118 @@ void dsp_fft_pitch_detect(int index) {
 	switch(index) {
 
 	   case FORMANT_G4:
-	      printf("400Hz pitch detected! \n");
+	      TLOG("400Hz pitch detected! \n");
 	      break;
 
 	   case FORMANT_G5:
-		  printf("800Hz pitch detected! \n");
+		  TLOG("800Hz pitch detected! \n");
 		  break;
 
 	   case FORMANT_B5:
-		  printf("1000Hz pitch detected! \n");
+		  TLOG("1000Hz pitch detected! \n");
 		  break;
 
 	   case FORMANT_D_SHARP6:
-		  printf("1250Hz pitch detected! \n");
+		  TLOG("1250Hz pitch detected! \n");
 		  break;
 
 	   case FORMANT_E_FLAT7:
-		  printf("2500Hz pitch detected! \n");
+		  TLOG("2500Hz pitch detected! \n");
 		  break;
 
 	   case FORMANT_G7:
-		  printf("3150Hz pitch detected! \n");
+		  TLOG("3150Hz pitch detected! \n");
 		  break;
 
 	   case FORMANT_B7:
-		  printf("4000Hz pitch detected! \n");
+		  TLOG("4000Hz pitch detected! \n");
 		  break;
 
 	   default :
-		   printf("No input signal detected/pitch out of range \n");
+		   TLOG("No input signal detected/pitch out of range (bin %d) \n", index);
 	}
 }
 
+// returns log2(n) if n is a supported power of two transform length, else -1
+static int dsp_fft_log2_len(int n) {
+
+  if (n < DSP_FFT_MIN_SAMPLES || n > DSP_FFT_MAX_SAMPLES || (n & (n - 1)) != 0) {
+    return -1;
+  }
+
+  int log2n = 0;
+  while ((1 << log2n) < n) {
+    ++log2n;
+  }
+  return log2n;
+}
+
 // see .h for more details
-int16_t* dsp_fft_mag(uint16_t* samples, int nsamples) {
+void dsp_dc_reset(dsp_dc_t* dc) {
+  dc->acc = 0;
+  dc->primed = false;
+}
+
+// see .h for more details
+uint16_t dsp_dc_offset(const dsp_dc_t* dc) {
+  return (uint16_t)((1 << 15) + (dc->acc >> DSP_DC_SHIFT));
+}
 
-  // handle error:
-  if (samples==NULL || nsamples != MAXSAMPLES) return NULL;
+// see .h for more details
+DSP_RAMFUNC(dsp_fft_mag)
+int16_t* dsp_fft_mag(const uint16_t* samples, int nsamples) {
+  return dsp_fft_mag_dc(samples, nsamples, NULL);
+}
+
+// see .h for more details
+DSP_RAMFUNC(dsp_fft_mag_dc)
+int16_t* dsp_fft_mag_dc(const uint16_t* samples, int nsamples, dsp_dc_t* dc) {
+
+  // handle error: only power of two lengths the CMSIS rfft supports
+  int log2n = dsp_fft_log2_len(nsamples);
+  if (samples==NULL || log2n < 0) return NULL;
 
   arm_rfft_instance_q15 fft_q15_ctx = {0};
   q15_t FFT_input[nsamples];
   q15_t FFT_output[2*nsamples];
-    
-  // normalize samples to q15_t type from uint16_t type
-  for (int i=0; i<nsamples; i++) {
-    // shift down
-    FFT_input[i] = (int16_t)(samples[i]-(1<<15));
-    // apply Hanning Window to filter out edge discontinuity
-    FFT_input[i] = ((q31_t)FFT_input[i]*hanning[i])>>15;
+
+  // the Hanning table is 512 points (2^9), other lengths step through it
+  // with a shift so the device path never needs a divide
+  int win_shift = 9 - log2n;
+
+  if (dc == NULL) {
+    // normalize samples to q15_t type from uint16_t type
+    for (int i=0; i<nsamples; i++) {
+      int w = (win_shift >= 0) ? (i << win_shift) : (i >> -win_shift);
+      // shift down
+      FFT_input[i] = (int16_t)(samples[i]-(1<<15));
+      // apply Hanning Window to filter out edge discontinuity
+      FFT_input[i] = ((q31_t)FFT_input[i]*hanning[w])>>15;
+    }
+  } else {
+    int32_t acc = dc->acc;
+    // the first frame starts the tracker at its mean, not at the bias
+    if (!dc->primed) {
+      int32_t sum = 0;
+      for (int i=0; i<nsamples; i++) {
+        sum += (int32_t)samples[i] - (1<<15);
+      }
+      acc = (sum >> log2n) * (1 << DSP_DC_SHIFT);
+      dc->primed = true;
+    }
+    for (int i=0; i<nsamples; i++) {
+      int w = (win_shift >= 0) ? (i << win_shift) : (i >> -win_shift);
+      int32_t x = (int32_t)samples[i] - (1<<15);
+      // the DC estimate follows x with a pole at 1 - 2^-DSP_DC_SHIFT, and
+      // x minus the estimate is the high-passed sample
+      acc += x - ((acc + (1 << (DSP_DC_SHIFT - 1))) >> DSP_DC_SHIFT);
+      int32_t y = x - ((acc + (1 << (DSP_DC_SHIFT - 1))) >> DSP_DC_SHIFT);
+      if (y > INT16_MAX) y = INT16_MAX;
+      if (y < INT16_MIN) y = INT16_MIN;
+      // apply Hanning Window to filter out edge discontinuity
+      FFT_input[i] = ((q31_t)y*hanning[w])>>15;
+    }
+    dc->acc = acc;
   }
   
   // initialize the real fft
@@ -137,7 +251,7 @@ int16_t* dsp_fft_mag(uint16_t* samples, int nsamples) {
 
 
 // the Hanning smoothing window
-static const int16_t hanning[MAXSAMPLES] = {
+static const int16_t hanning[MAXSAMPLES] DSP_RAMDATA(hanning) = {
     0,     1,     4,    11,    19,    30,    44,    60,
    79,   100,   123,   149,   178,   208,   242,   277,
   316,   356,   399,   445,   492,   543,   595,   650,
@@ -11,12 +11,56 @@
  *
  * Reference:  https://www.keil.com/pack/doc/CMSIS/DSP/html/group__RealFFT.html
  *
+ * At 48 MHz the flash needs a wait state and the MCM cache is small, so the
+ * FFT can run from SRAM instead. DSP_FFT_RAMFUNC puts dsp_fft_mag() and
+ * dsp_fft_peak_bin() in their own .ramfunc.<name> sections, which the managed
+ * linker script places in .data, so ResetISR copies them to SRAM. The CMSIS
+ * library is prebuilt; `make DSP_RAMFUNC=1` relocates its hot path the same
+ * way (radix-4 butterflies, cfft/rfft stages, bit reversal, magnitude), see
+ * makefile.targets. Calls between flash and SRAM go through linker veneers.
+ * `bench` in the shell times the pipeline with the flash cache on and off;
+ * build with and without the options for the A/B comparison.
+ *
+ * dsp_fft_mag() removes a fixed 1<<15 mic bias. The real bias is off by a few
+ * hundred counts (about 33000 in the MATLAB vector), and through the Hann
+ * window that DC leaks into bin 1, where G4 is. dsp_fft_mag_dc() instead
+ * subtracts a running DC estimate while it converts to q15, in the same pass.
+ * That is a first order DC-blocking high-pass, -3 dB at
+ * 8192 / (2 pi 2^DSP_DC_SHIFT) Hz (2.5 Hz) and -0.1 dB at bin 1 (16 Hz). The
+ * estimate lives in a dsp_dc_t, one per input channel, and carries over from
+ * frame to frame.
+ *
+ * Build options:
+ * 	DSP_DC_SHIFT     DC tracker time constant, 2^n samples (default 9)
+ * 	DSP_FFT_RAMFUNC  run dsp_fft_mag() and dsp_fft_peak_bin() from SRAM
+ * 	DSP_FFT_RAMDATA  keep the Hanning table in SRAM (1 KB), pairs with
+ * 	                 make DSP_RAMFUNC_TABLES=1 for the 256 point CFFT tables
+ *
  */
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifndef _DSP_FFT_H_
 #define _DSP_FFT_H_
 
+#ifndef DSP_DC_SHIFT
+#define DSP_DC_SHIFT (9)
+#endif
+
+// DC tracker state of one input channel, see dsp_fft_mag_dc()
+typedef struct {
+  int32_t acc;              // DC estimate relative to 1<<15, times 2^DSP_DC_SHIFT
+  bool primed;              // false until the first frame has set acc
+} dsp_dc_t;
+
+// Describe the major formants in the PDA (FFT bin returned by dsp_fft_max_pitch)
+#define FORMANT_G4    	 (1)
+#define FORMANT_G5	  	 (3)
+#define FORMANT_B5		 (5)
+#define FORMANT_D_SHARP6 (4)
+#define FORMANT_E_FLAT7  (9)
+#define FORMANT_G7		 (11)
+#define FORMANT_B7		 (14)
 
 /* @brief   Returns the NORM of a 512 sample real FFT in array form
  * 
@@ -24,11 +68,38 @@
  * after the FFT has been performed
  *
  * @param   data,  the sampled data casted as uint16_t (ADC0)
- *          nsamples, 512 sample FFT
+ *          nsamples, 512 sample FFT on the device; any power of two from 64 up to
+ *                    DSP_FFT_MAX_SAMPLES is accepted (host benchmarks sweep this)
  *
  * @return  int16_t, of the real and imaginary parts of the FFT
+ *          NULL if data is NULL or nsamples is not a supported length
+ */
+int16_t* dsp_fft_mag(const uint16_t* data, int nsamples);
+
+/* @brief   dsp_fft_mag() with the mic bias tracked instead of fixed at 1<<15
+ *
+ * @param   data, the sampled data casted as uint16_t (ADC0)
+ *          nsamples, as dsp_fft_mag()
+ *          dc, state of the channel data came from, updated; NULL behaves
+ *              like dsp_fft_mag()
+ *
+ * @return  as dsp_fft_mag()
+ */
+int16_t* dsp_fft_mag_dc(const uint16_t* data, int nsamples, dsp_dc_t* dc);
+
+/* @brief   Starts a channel's DC tracker over, the next frame primes it
+ *
+ * @param   dc, state to clear
+ * @return  none
+ */
+void dsp_dc_reset(dsp_dc_t* dc);
+
+/* @brief   Current mic bias estimate of a channel
+ *
+ * @param   dc, state
+ * @return  bias in ADC counts
  */
-int16_t* dsp_fft_mag(uint16_t* data, int nsamples);
+uint16_t dsp_dc_offset(const dsp_dc_t* dc);
 
 /* @brief  Locates which frequency bin the speech formant is centered around.
  *
@@ -43,6 +114,25 @@ int16_t* dsp_fft_mag(uint16_t* data, int nsamples);
  */
 uint16_t dsp_fft_max_pitch(int16_t* fft_mag);
 
+/* @brief  Plain argmax over the first dsp_fft_search_bins() bins, no formant corrections
+ *
+ * @param  fft_mag, magnitude array of the FFT result
+ *
+ * @return  index of the strongest bin
+ */
+uint16_t dsp_fft_peak_bin(const int16_t* fft_mag);
+
+/* @brief  Runtime tuning of the pitch search, see shell.h
+ *
+ * search_bins:  bins dsp_fft_max_pitch() searches, 2 to half the transform (default 32)
+ * b5_threshold: bin 4 power above which a bin 3 peak is reported as B5 (bin 5),
+ *               0 disables the correction (default 64)
+ */
+void dsp_fft_set_search_bins(int bins);
+int dsp_fft_search_bins();
+void dsp_fft_set_b5_threshold(int16_t threshold);
+int16_t dsp_fft_b5_threshold();
+
 /* @brief  Finds the pitch by comparing fundamental frequency and subsequent harmonics
  *
  * This function identifies which of the predetermined speech formants is found by
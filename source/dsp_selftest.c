@@ -0,0 +1,72 @@
+/*
+ * @file dsp_selftest.c
+ *
+ * @brief	Built-in pipeline self-test, see dsp_selftest.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <crc16.h>
+#include <dsp_fft.h>
+#include <dsp_selftest.h>
+
+#define SELFTEST_NSAMPLES (64)
+#define SELFTEST_NBINS    (32)
+#define SELFTEST_TONE_BIN     (5)
+#define SELFTEST_HARMONIC_BIN (10)
+
+/* 640 Hz (bin 5 of 64) plus a -12 dB second harmonic on the mic bias:
+ * round(32768 + 12000*cos(2*pi*5*n/64 + 0.3) + 3000*cos(2*pi*10*n/64 + 1.1))
+ */
+static const uint16_t selftest_vector[SELFTEST_NSAMPLES] = {
+  45593, 39740, 33198, 28506, 26033, 24544, 23113, 22473,
+  24496, 30217, 38249, 45139, 47569, 44642, 38380, 32066,
+  27861, 25703, 24257, 22868, 22605, 25349, 31729, 39843,
+  46055, 47385, 43554, 37023, 31026, 27302, 25400, 23965,
+  22665, 22862, 26357, 33317, 41360, 46767, 46984, 42355,
+  35693, 30085, 26819, 25111, 23672, 22520, 23257, 27512,
+  34953, 42767, 47261, 46381, 41074, 34412, 29246, 26401,
+  24828, 23385, 22450, 23799, 28804, 36608, 44035, 47529
+};
+
+// the tone at bin 5 is the peak and its harmonic the largest bin past the
+// Hann main lobe (bins 4..6), which holds however the CMSIS build rounds
+static bool selftest_shape(const int16_t* fft_mags, uint16_t bin) {
+  if (bin != SELFTEST_TONE_BIN || fft_mags[SELFTEST_HARMONIC_BIN] <= 0) {
+    return false;
+  }
+  for (int i = SELFTEST_TONE_BIN + 2; i < SELFTEST_NBINS; i++) {
+    if (i != SELFTEST_HARMONIC_BIN && fft_mags[i] >= fft_mags[SELFTEST_HARMONIC_BIN]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// see .h for more details
+uint16_t dsp_selftest_crc() {
+
+  int16_t* fft_mags = dsp_fft_mag(selftest_vector, SELFTEST_NSAMPLES);
+  if (fft_mags == NULL) {
+    return 0;
+  }
+
+  uint16_t bin = dsp_fft_max_pitch(fft_mags);
+  uint16_t crc = crc16_ccitt(CRC16_INIT, fft_mags, SELFTEST_NBINS * sizeof(int16_t));
+  return crc16_ccitt(crc, &bin, sizeof(bin));
+}
+
+// see .h for more details
+bool dsp_selftest() {
+  int16_t* fft_mags = dsp_fft_mag(selftest_vector, SELFTEST_NSAMPLES);
+  if (fft_mags == NULL || !selftest_shape(fft_mags, dsp_fft_max_pitch(fft_mags))) {
+    return false;
+  }
+  // the CRC compares bit for bit once it is recorded
+  return (DSP_SELFTEST_CRC == 0) || (dsp_selftest_crc() == DSP_SELFTEST_CRC);
+}
@@ -0,0 +1,48 @@
+/*
+ * @file dsp_selftest.h
+ *
+ * @brief	Fast built-in self-test of the FFT pipeline for every boot
+ *
+ * Runs a 64 sample tone through dsp_fft_mag() and dsp_fft_max_pitch(). The
+ * tone has to come out as the peak bin and its second harmonic as the largest
+ * bin past the tone's main lobe. Once DSP_SELFTEST_CRC is recorded, a CRC-16
+ * of the first 32 power bins and the detected bin must also match it. It takes well under a millisecond and uses no printf, so
+ * it replaces the full MATLAB regression (test_dsp) in the startup path.
+ * The full regression now runs in test builds (DSP_UNIT_TESTS) and on the host.
+ *
+ * Build options:
+ * 	DSP_SELFTEST_DISABLE  skip the self-test at boot
+ * 	DSP_SELFTEST_CRC      expected CRC, print it on the host with
+ * 	                      make -C tools/host test. 0 means not recorded and
+ * 	                      only the spectrum shape is checked
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _DSP_SELFTEST_H_
+#define _DSP_SELFTEST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef DSP_SELFTEST_CRC
+#define DSP_SELFTEST_CRC (0x0000U)
+#endif
+
+/* @brief   CRC-16 of the pipeline output for the built-in vector
+ *
+ * @param   none
+ * @return  CRC over the first 32 bins of dsp_fft_mag() and the dsp_fft_max_pitch() bin
+ */
+uint16_t dsp_selftest_crc();
+
+/* @brief   Checks the pipeline output for the built-in vector
+ *
+ * @param   none
+ * @return  true if the spectrum shape and, when recorded, the CRC match
+ */
+bool dsp_selftest();
+
+#endif // _DSP_SELFTEST_H_
@@ -0,0 +1,68 @@
+/*
+ * @file flash_store.c
+ *
+ * @brief	Interrupt-safe flash programming, see flash_store.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "MKL25Z4.h"
+#include "fsl_flash.h"
+#include <flash_store.h>
+
+static flash_config_t flash_config;
+static bool flash_ready;
+
+// see .h for more details
+bool flash_store_init() {
+  if (flash_ready) {
+    return true;
+  }
+  if (FLASH_Init(&flash_config) != kStatus_FLASH_Success) {
+    return false;
+  }
+  if (FLASH_PrepareExecuteInRamFunctions(&flash_config) != kStatus_FLASH_Success) {
+    return false;
+  }
+  flash_ready = true;
+  return true;
+}
+
+// see .h for more details
+bool flash_store_program_word(uint32_t addr, uint32_t value) {
+  status_t status;
+
+  // no vector or ISR fetch from flash while the command runs
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  status = FLASH_Program(&flash_config, addr, &value, sizeof(value));
+  __set_PRIMASK(primask);
+
+  return status == kStatus_FLASH_Success;
+}
+
+// see .h for more details
+bool flash_store_erase_sector(uint32_t addr) {
+  status_t status;
+
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  status = FLASH_Erase(&flash_config, addr, FLASH_STORE_SECTOR_SIZE, kFLASH_ApiEraseKey);
+  __set_PRIMASK(primask);
+
+  return status == kStatus_FLASH_Success;
+}
+
+// see .h for more details
+bool flash_store_is_blank(uint32_t addr, uint32_t len) {
+  for (uint32_t i = 0; i < len; i += 4) {
+    if (flash_store_read_word(addr + i) != FLASH_STORE_ERASED) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,73 @@
+/*
+ * @file flash_store.h
+ *
+ * @brief	Word programming and sector erase of the program flash through
+ * 			drivers/fsl_flash.c, safe to call while the application runs
+ *
+ * The KL25Z has a single flash block, so the core cannot fetch code or
+ * vectors from it while a command runs. The driver's wait loop runs from RAM
+ * (FLASH_PrepareExecuteInRamFunctions) and interrupts are masked for the
+ * duration of each command; DMA keeps moving ADC samples meanwhile.
+ *
+ * 	program one word   ~65 us typical, 145 us worst (interrupts held off)
+ * 	erase one sector   ~14 ms typical, 114 ms worst
+ *
+ * A word program is longer than one character at 115200 baud (~87 us) and
+ * UART0 has no receive FIFO, so a character that arrives meanwhile is lost.
+ * main() holds the capture log off while a shell line is being typed
+ * (shell_rx_pending()). Only the first character of a line can still be lost.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _FLASH_STORE_H_
+#define _FLASH_STORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLASH_STORE_SECTOR_SIZE (1024U)
+#define FLASH_STORE_ERASED      (0xFFFFFFFFU)
+
+/* @brief   Initializes the flash driver and copies its wait loop to RAM
+ *
+ * @param   none
+ * @return  true on success
+ */
+bool flash_store_init();
+
+/* @brief   Programs one 32-bit word, the word must be erased
+ *
+ * @param   addr, word aligned flash address
+ *          value, word to program
+ * @return  true on success
+ */
+bool flash_store_program_word(uint32_t addr, uint32_t value);
+
+/* @brief   Erases one sector
+ *
+ * @param   addr, sector aligned flash address
+ * @return  true on success
+ */
+bool flash_store_erase_sector(uint32_t addr);
+
+/* @brief   Whether every word in [addr, addr + len) reads erased
+ *
+ * @param   addr, word aligned flash address
+ *          len, bytes, a multiple of 4
+ * @return  true if blank
+ */
+bool flash_store_is_blank(uint32_t addr, uint32_t len);
+
+/* @brief   Reads a word of flash
+ *
+ * @param   addr, word aligned flash address
+ * @return  the word
+ */
+static inline uint32_t flash_store_read_word(uint32_t addr) {
+  return *(const volatile uint32_t*)addr;
+}
+
+#endif // _FLASH_STORE_H_
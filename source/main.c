@@ -11,6 +11,20 @@
 #include "analog_peripherals.h"
 #include "leds.h"
 #include "touch_sensor.h"
+#include "mem_usage.h"
+#include "mtb_trace.h"
+#include "dsp_selftest.h"
+#include "telemetry.h"
+#include "app_config.h"
+#include "shell.h"
+#include "cpu_cycles.h"
+#include "standby.h"
+#include "capture_log.h"
+#include "tlog.h"
+#include "boot_profile.h"
+#include "scheduler.h"
+#include "note_tracker.h"
+#include "tuner.h"
 #include <stdio.h>
 #include <test_dsp_fft.h>
 #include <tpm_sync.h>
@@ -21,81 +35,443 @@
 #include "MKL25Z4.h"
 #include "fsl_debug_console.h"
 
+// sweeps the slider must be held before it changes the gate (~0.5 s)
+#define SLIDER_HOLD_SWEEPS ((app_config.tsi_scan_hz > 1) ? (app_config.tsi_scan_hz >> 1) : 200)
+
+// channel 10 is both the record pad and slider electrode B: the finger must
+// travel this far along the slider (of 0..1023) before a hold sets the gate
+#define SLIDER_GATE_MOTION (128)
+
+// slider position to min_magnitude, 0..127; noise is 0-2 and a full scale tone ~512
+#define SLIDER_GATE_SHIFT (3)
+
+// samples (~8 ms) a shell or flash run needs before the next block is due
+#define BACKGROUND_SLACK (64U)
+
+// note events waiting for the LOG task, power of two
+#define NOTE_QUEUE_SIZE (8U)
+
+// weakest peak the tuner reports while min_magnitude is lower, noise is 0-2
+#define TUNER_MIN_POWER (4)
+
 void system_init() {
+  // free running SysTick for ISR and phase timing, already running unless
+  // BOOT_PROFILE_DISABLE
+  cpu_cycles_init();
+
   // initialize hardware
   BOARD_InitBootPins();
+  boot_profile_mark(BOOT_PHASE_PINS);
+#if defined(BOOT_FAST_START)
+  // crystal and PLL were started in ResetISR, see boot_profile.h
+  boot_clock_finish();
+  boot_profile_mark(BOOT_PHASE_CLOCKS);
+
+  // the ADC calibration runs while the console and UI are set up
+  analog_init_begin();
+  boot_profile_mark(BOOT_PHASE_ANALOG);
+#else
   BOARD_InitBootClocks();
+  boot_profile_mark(BOOT_PHASE_CLOCKS);
+#endif
   BOARD_InitBootPeripherals();
 
 #ifdef DEBUG
   // initialize debug console
   BOARD_InitDebugConsole();
 #endif
-  
+  boot_profile_mark(BOOT_PHASE_CONSOLE);
+
+#if defined(BOOT_FAST_START)
+  // TSI baselines come from the first sweep, so nothing here waits
+  init_rgb_led();
+  touch_sensor_init((1 << TSI_SLIDER_CHANNEL_A) | (1 << TSI_SENSOR_CHANNEL));
+  boot_profile_mark(BOOT_PHASE_TOUCH);
+
+  // wait for the calibration and start sampling
+  analog_init_end();
+  boot_profile_mark(BOOT_PHASE_ADC_WAIT);
+#else
   // initialize ADC controls that communicate with external microphone
   analog_init();
+  boot_profile_mark(BOOT_PHASE_ANALOG);
+#endif
 
   // initialize the TPM clocks
   init_tpm_sync();
 }
 
 
+// frame state the tasks share, they all run in thread mode (scheduler.h)
+static uint16_t current_bin;
+static int16_t *fft_mags;
+static uint32_t current_frame;
+static bool g_recording;
+static bool g_output;
+static bool touch_pressed;          // a press arrived since the last frame
+static uint32_t idle_frames;
+static uint16_t slider_anchor = SLIDER_POSITION_MAX + 1;  // where the finger landed, > MAX none
+static bool slider_moved;           // it has since moved SLIDER_GATE_MOTION
+static bool flash_posted;           // a FLASH run is already queued
+static dsp_dc_t mic_dc;             // bias of channel 0, the channel the detector runs on
+static note_tracker_t note_tracker;
+// DSP task to LOG task, both in thread mode so no barriers
+static note_event_t note_queue[NOTE_QUEUE_SIZE];
+static uint32_t note_head, note_tail;
+static tuner_note_t tuner_reading;
+
+// continuous mode reports note events, not every frame
+static bool notes_enabled() {
+  return app_config.mode == MODE_CONTINUOUS && app_config.notes;
+}
+
+// the touch task reports the detector's bin, in the other modes the note
+// tracker or the tuner does
+static bool bin_reports() {
+  return app_config.mode == MODE_TOUCH || (app_config.mode == MODE_CONTINUOUS && !app_config.notes);
+}
+
+// runs the tracker on the frame's bin and queues its events
+static void note_track_frame() {
+  note_event_t events[2];
+  bool voiced = fft_mags[current_bin] >= app_config.min_magnitude;
+  uint32_t n = note_tracker_update(&note_tracker, current_bin, voiced, events);
+
+  if(n == 0 || !notes_enabled()) {
+    return;
+  }
+  for(uint32_t i = 0; i < n; i++) {
+    if(note_head - note_tail == NOTE_QUEUE_SIZE) {
+      break;
+    }
+    note_queue[note_head++ & (NOTE_QUEUE_SIZE - 1)] = events[i];
+#if !defined(CAPTURE_LOG_DISABLE)
+    if(events[i].type == NOTE_EVENT_ON && app_config.capture != CAPTURE_OFF) {
+      capture_event(current_frame, events[i].bin, fft_mags[events[i].bin]);
+    }
+#endif
+  }
+  sched_post(SCHED_TASK_LOG, SCHED_EV_NOTE);
+}
+
+// tuner mode: note, octave and cents of the frame for the LOG task
+static void tuner_frame() {
+  int16_t min_power = (app_config.min_magnitude > TUNER_MIN_POWER) ? app_config.min_magnitude
+                                                                    : TUNER_MIN_POWER;
+  if(tuner_estimate(fft_mags, min_power, &tuner_reading) && app_config.verbosity >= 1) {
+    sched_post(SCHED_TASK_LOG, SCHED_EV_TUNER);
+  }
+}
+
+// SCHED_TASK_DSP: one ADC block, the only deadline bound work
+static void dsp_task(uint8_t event) {
+  (void)event;
+
+#if !defined(CAPTURE_LOG_DISABLE)
+  // the buffer a raw capture reads from is about to go back to the DMA
+  capture_log_release_frame();
+#endif
+  // get ADC samples from microphone (also begins new sampling sequence) swap ping-pong,
+  // NULL if the block was taken already (standby restarts sampling)
+  uint16_t *samples = get_samples();
+  if(samples == NULL) {
+    return;
+  }
+  standby_frame_ready();
+  if(app_config.frames == 0) {
+    boot_profile_mark(BOOT_PHASE_FIRST_FRAME);
+  }
+
+#if defined(MTB_TRACE_FRAMES)
+  bool g_tracing = mtb_trace_take_request();
+  if(g_tracing) {
+    mtb_trace_start(false);
+  }
+#endif
+
+  // 1D transform of current signal's power spectrum
+  fft_mags = dsp_fft_mag_dc(samples, 512, app_config.dc_block ? &mic_dc : NULL);
+
+#if !defined(CAPTURE_LOG_DISABLE)
+  // the FFT has its own copy now, the block is encoded in place
+  if(app_config.capture == CAPTURE_FRAMES) {
+    capture_frame(app_config.frames, samples, 512, (codec_t)app_config.codec);
+  }
+#endif
+
+  // compute the current bin number of the FFT that contains most energy (PARSEVAL THM)
+  if(app_config.detector == DETECTOR_ARGMAX) {
+    current_bin = dsp_fft_peak_bin(fft_mags);
+  } else {
+    current_bin = dsp_fft_max_pitch(fft_mags);
+  }
+
+#if defined(MTB_TRACE_FRAMES)
+  if(g_tracing) {
+    mtb_trace_stop();
+    mtb_trace_dump();
+  }
+#endif
+  current_frame = app_config.frames++;
+
+  // O(states), a few hundred cycles
+  note_track_frame();
+  if(app_config.mode == MODE_TUNER) {
+    tuner_frame();
+  }
+
+  // the rest of the frame runs by priority, console and flash work last
+  sched_post(SCHED_TASK_TOUCH, SCHED_EV_FRAME);
+  if(app_config.telemetry || app_config.verbosity >= 2) {
+    sched_post(SCHED_TASK_LOG, SCHED_EV_FRAME);
+  }
+#if !defined(CAPTURE_LOG_DISABLE)
+  if(!flash_posted) {
+    flash_posted = sched_post(SCHED_TASK_FLASH, SCHED_EV_FRAME);
+  }
+#endif
+}
+
+// SCHED_TASK_TOUCH: touch events as they arrive, the UI state once per frame
+static void touch_task(uint8_t event) {
+
+  // presses are detected in the TSI interrupt
+  touch_event_t touch;
+  while(touch_event_get(&touch)) {
+    if(touch.channel == TSI_SENSOR_CHANNEL && touch.type == TOUCH_PRESS) {
+      touch_pressed = true;
+    }
+    idle_frames = 0;
+  }
+  if(event != SCHED_EV_FRAME) {
+    return;
+  }
+  if(touch_is_pressed(TSI_SENSOR_CHANNEL)) {
+    idle_frames = 0;
+  }
+
+  // nobody has touched the board for standby_s seconds (16 frames per second):
+  // sleep until the slider is touched, acquisition restarts on the way out
+  if(app_config.mode == MODE_TOUCH && app_config.standby_s > 0 &&
+     ++idle_frames >= ((uint32_t)app_config.standby_s << 4)) {
+    standby_enter();
+    idle_frames = 0;
+  }
+
+  // sliding and then holding sets the reporting gate; a tap or a hold of the
+  // record pad does not move the finger and only records
+  touch_slider_t slider;
+  touch_slider_get(&slider);
+  if(!slider.touched) {
+    slider_anchor = SLIDER_POSITION_MAX + 1;
+    slider_moved = false;
+  } else if(slider_anchor > SLIDER_POSITION_MAX) {
+    slider_anchor = slider.position;
+  } else if(slider.position >= slider_anchor + SLIDER_GATE_MOTION ||
+            slider.position + SLIDER_GATE_MOTION <= slider_anchor) {
+    slider_moved = true;
+  }
+  if(slider_moved && slider.held_sweeps >= SLIDER_HOLD_SWEEPS &&
+     (slider.position >> SLIDER_GATE_SHIFT) != app_config.min_magnitude) {
+    app_config.min_magnitude = slider.position >> SLIDER_GATE_SHIFT;
+    sched_post(SCHED_TASK_LOG, SCHED_EV_GATE);
+  }
+
+  if(app_config.mode != MODE_TOUCH) {
+    g_recording = true;
+    g_output = true;
+  }
+  else if(touch_pressed && g_recording == false) {
+    //begin recording
+    sched_post(SCHED_TASK_LED, SCHED_EV_LED_RECORD);
+    g_recording = true;
+    g_output = true;
+  }
+  touch_pressed = false;
+
+  if(g_recording) {
+    // end recording
+    sched_post(SCHED_TASK_LED, SCHED_EV_LED_IDLE);
+    g_recording = false;
+    if(g_output) {
+      // compare extracted harmonics to precomputed signal values,
+      // with note events on or in tuner mode, dsp_task reports instead
+      if(bin_reports() && fft_mags[current_bin] >= app_config.min_magnitude) {
+        if(app_config.verbosity >= 1) {
+          sched_post(SCHED_TASK_LOG, SCHED_EV_PITCH);
+        }
+#if !defined(CAPTURE_LOG_DISABLE)
+        // only queued here, the FLASH task programs it
+        if(app_config.capture != CAPTURE_OFF) {
+          capture_event(current_frame, current_bin, fft_mags[current_bin]);
+        }
+#endif
+      }
+      g_output = false;
+    }
+  }
+}
+
+// SCHED_TASK_LED
+static void led_task(uint8_t event) {
+  if(event == SCHED_EV_LED_RECORD) {
+    green_led_off();
+    red_led_on();
+  } else if(event == SCHED_EV_LED_IDLE) {
+    red_led_off();
+    green_led_on();
+  }
+}
+
+// SCHED_TASK_LOG: console output for the frame the DSP task just finished
+static void log_task(uint8_t event) {
+  if(event == SCHED_EV_PITCH) {
+    dsp_fft_pitch_detect(current_bin);
+    return;
+  }
+  if(event == SCHED_EV_TUNER) {
+    // e.g. "tuner A4 -3 cents (439 Hz)"
+    const char* name = tuner_note_name(tuner_reading.note);
+    if(name[1] == '#') {
+      TLOG("tuner %c#%d %d cents (%d Hz)\r\n", name[0], tuner_reading.octave, tuner_reading.cents,
+           tuner_reading.freq_q4 >> 4);
+    } else {
+      TLOG("tuner %c%d %d cents (%d Hz)\r\n", name[0], tuner_reading.octave, tuner_reading.cents,
+           tuner_reading.freq_q4 >> 4);
+    }
+    return;
+  }
+  if(event == SCHED_EV_GATE) {
+    // the slider changed it, otherwise nothing on the console shows why reports stop
+    if(app_config.verbosity >= 1) {
+      TLOG("min_magnitude %d\r\n", app_config.min_magnitude);
+    }
+    return;
+  }
+  if(event == SCHED_EV_NOTE) {
+    // 16 Hz per bin
+    while(note_tail != note_head) {
+      note_event_t* e = &note_queue[note_tail++ & (NOTE_QUEUE_SIZE - 1)];
+      if(app_config.verbosity < 1) {
+        continue;
+      }
+      if(e->type == NOTE_EVENT_ON) {
+        TLOG("note on bin %d (%d Hz) confidence %d\r\n", e->bin, e->bin << 4, e->confidence);
+      } else {
+        TLOG("note off bin %d (%d Hz)\r\n", e->bin, e->bin << 4);
+      }
+    }
+    return;
+  }
+#if !defined(TELEMETRY_DISABLE)
+  // binary pitch/peak records for tools/telem_decode.py
+  if(app_config.telemetry) {
+    telem_frame(current_frame, fft_mags, 512, current_bin);
+  }
+#endif
+  if(app_config.verbosity >= 2) {
+    TLOG("frame %lu bin %d mag %d\r\n", current_frame, current_bin, fft_mags[current_bin]);
+  }
+}
+
+#if !defined(SHELL_DISABLE)
+// SCHED_TASK_SHELL: a bounded number of characters per run
+static void shell_task(uint8_t event) {
+  (void)event;
+  if(shell_poll()) {
+    idle_frames = 0;
+    // more may be waiting in the ring
+    sched_post(SCHED_TASK_SHELL, SCHED_EV_RX);
+  }
+}
+#endif
+
+#if !defined(CAPTURE_LOG_DISABLE)
+// SCHED_TASK_FLASH: flash programming in the time left before the next block
+static void flash_task(uint8_t event) {
+  (void)event;
+  flash_posted = false;
+#if !defined(SHELL_DISABLE)
+  // a word program outlasts a character time and UART0 has no FIFO, keep
+  // the flash quiet while a command is being typed
+  if(shell_rx_pending()) {
+    return;
+  }
+#endif
+  capture_log_service();
+}
+#endif
+
 int main(void) {
 
+  // .data/.bss and the stack paint done, see ResetISR
+  boot_profile_mark(BOOT_PHASE_RESET);
+
   // initialize the FRDM-kl25z board to a default state
   system_init();
 
+  // sampling runs from here on, the rest fits in the wait for the first block
+#if !defined(BOOT_FAST_START)
   // initialize UI
   init_rgb_led();
-  touch_sensor_init((1 << TSI_SENSOR_CHANNEL));
-
-  // run tests
-  printf("Number of passing Unit Tests %d/5 \r\n", test_dsp());
-
-  // local and global variables to keep track of application status
-  uint16_t current_bin;
-  uint16_t *samples;
-  int16_t *fft_mags;
-  bool g_recording = false;
-  bool g_output    = false;
+  touch_sensor_init((1 << TSI_SLIDER_CHANNEL_A) | (1 << TSI_SENSOR_CHANNEL));
+  boot_profile_mark(BOOT_PHASE_TOUCH);
+#endif
 
+#if !defined(SHELL_DISABLE)
+  // runtime tuning over the console UART, see shell.h
+  shell_init();
+  boot_profile_mark(BOOT_PHASE_SHELL);
+#endif
 
-  // main program loop
-  while(1){
+  // stop modes allowed, TSI and LPTMR routed to the LLWU
+  standby_init();
+  boot_profile_mark(BOOT_PHASE_STANDBY);
 
-		  // wait for ADC sampling to complete and be available for reading
-		  while( !is_adc_pong_full() ) {;}
-		  // get ADC samples from microphone (also begins new sampling sequence) swap ping-pong
-		  samples = get_samples();
+#if !defined(CAPTURE_LOG_DISABLE)
+  // flash capture log above the image, see capture_log.h
+  capture_log_init();
+  boot_profile_mark(BOOT_PHASE_CAPTURE_LOG);
+#endif
 
-		  // 1D transform of current signal's power spectrum
-		  fft_mags = dsp_fft_mag(samples, 512);
+#if defined(DSP_UNIT_TESTS)
+  // run the full MATLAB regression, test builds only
+  printf("Number of passing Unit Tests %d/5 \r\n", test_dsp());
+  printf("Stack high-water mark %lu/%lu bytes \r\n",
+         (unsigned long)stack_high_water_mark(), (unsigned long)stack_reserved());
+#endif
 
-		  // compute the current bin number of the FFT that contains most energy (PARSEVAL THM)
-		  current_bin = dsp_fft_max_pitch(fft_mags);
+#if !defined(DSP_SELFTEST_DISABLE)
+  // quick check of the FFT pipeline, blue LED flags a mismatch
+  if(!dsp_selftest()) {
+	  blue_led_on();
+  }
+#endif
+  boot_profile_mark(BOOT_PHASE_SELFTEST);
 
-		  if(touch_data(10) > TSI_THRESHOLD && g_recording == false) {
-			  //begin recording
-			  green_led_off();
-			  red_led_on();
-			  g_recording = true;
-			  g_output = true;
-		  }
-		  if(g_recording) {
-			  // end recording
-			  red_led_off();
-			  green_led_on();
-			  g_recording = false;
-			  if(g_output) {
-				  // compare extracted harmonics to precomputed signal values
-				  dsp_fft_pitch_detect(current_bin);
-				  g_output = false;
-			  }
+#if defined(MTB_TRACE_FRAMES)
+  // branch trace of the first frame for tools/mtb_decode.py
+  mtb_trace_request();
+#endif
 
-		  }
+  note_tracker_init(&note_tracker);
 
+  // the ISRs post to these (DMA0 -> DSP, TSI0 -> TOUCH, UART0 -> SHELL),
+  // blocks that completed during the boot are already queued
+  sched_set_slack_source(analog_samples_remaining);
+  sched_register(SCHED_TASK_DSP, dsp_task, 0);
+  sched_register(SCHED_TASK_TOUCH, touch_task, 0);
+  sched_register(SCHED_TASK_LED, led_task, 0);
+  sched_register(SCHED_TASK_LOG, log_task, 0);
+#if !defined(SHELL_DISABLE)
+  sched_register(SCHED_TASK_SHELL, shell_task, BACKGROUND_SLACK);
+#endif
+#if !defined(CAPTURE_LOG_DISABLE)
+  sched_register(SCHED_TASK_FLASH, flash_task, BACKGROUND_SLACK);
+#endif
 
-  }
+  // main program loop: run the tasks by priority, sleep when there is nothing to do
+  sched_run();
 
   return 1;
 
@@ -0,0 +1,47 @@
+/*
+ * @file mem_usage.c
+ *
+ * @brief	Stack high-water-mark queries over the paint laid down in ResetISR
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <mem_usage.h>
+
+// symbols from the managed linker script (ECEN5813_FinalProject_Debug.ld)
+extern uint32_t _pvHeapLimit;
+extern uint32_t _vStackBase;
+extern uint32_t _vStackTop;
+
+// lowest word of RAM the stack has written to
+static uint32_t* stack_lowest_write() {
+  uint32_t* p = &_pvHeapLimit;
+  while (p < &_vStackTop && *p == STACK_PAINT_PATTERN) {
+    ++p;
+  }
+  return p;
+}
+
+// see .h for more details
+uint32_t stack_high_water_mark() {
+  return (uint32_t)((uintptr_t)&_vStackTop - (uintptr_t)stack_lowest_write());
+}
+
+// see .h for more details
+uint32_t stack_headroom() {
+  return (uint32_t)((uintptr_t)stack_lowest_write() - (uintptr_t)&_pvHeapLimit);
+}
+
+// see .h for more details
+uint32_t stack_reserved() {
+  return (uint32_t)((uintptr_t)&_vStackTop - (uintptr_t)&_vStackBase);
+}
+
+// see .h for more details
+bool stack_overflowed() {
+  return stack_high_water_mark() > stack_reserved();
+}
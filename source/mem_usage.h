@@ -0,0 +1,60 @@
+/*
+ * @file mem_usage.h
+ *
+ * @brief	Runtime stack high-water-mark for the 16 KB of SRAM on the KL25Z
+ *
+ * ResetISR (startup_mkl25z4.c) paints every word between the end of the heap and
+ * the stack pointer with STACK_PAINT_PATTERN before main() runs. The stack grows
+ * down over the paint, so the lowest word that no longer holds the pattern marks
+ * the deepest the stack has ever been since reset.
+ *
+ * The static RAM split (.data/.bss per module) comes from the linker map instead,
+ * see tools/map_budget.py.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _MEM_USAGE_H_
+#define _MEM_USAGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define STACK_PAINT_PATTERN (0xDEADBEEFU)
+
+/* @brief   Deepest stack use since reset
+ *
+ * Scans up from the end of the heap for the first overwritten word, the cost is
+ * proportional to the unused RAM so call it from idle time, not per sample.
+ *
+ * @param   none
+ * @return  bytes between the top of SRAM and the lowest stack write
+ */
+uint32_t stack_high_water_mark();
+
+/* @brief   Untouched RAM left between the heap and the deepest stack write
+ *
+ * @param   none
+ * @return  bytes of paint still intact, 0 means the stack has reached the heap
+ */
+uint32_t stack_headroom();
+
+/* @brief   Stack size reserved by the linker script (_StackSize)
+ *
+ * @param   none
+ * @return  bytes reserved for the stack
+ */
+uint32_t stack_reserved();
+
+/* @brief   Whether the stack has grown past its linker script reservation
+ *
+ * Past the reservation the stack is eating RAM that the map file reports as free.
+ *
+ * @param   none
+ * @return  true if stack_high_water_mark() > stack_reserved()
+ */
+bool stack_overflowed();
+
+#endif // _MEM_USAGE_H_
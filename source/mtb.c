@@ -47,6 +47,8 @@
  *     		Allows MTB Buffer to be placed into specific RAM bank. When 
  *     		this is not defined, the "default" (first if there are 
  *     		several) RAM bank is used.
+ *
+ * 			See mtb_trace.h for capturing the buffer from the application.
  */
  
 /* This is a template for board specific configuration created by MCUXpresso IDE Project Wizard.*/
@@ -54,6 +56,9 @@
 // Allow MTB to be removed by setting a define (via command line)
 #if !defined (__MTB_DISABLE)
 
+  // Buffer size shared with the capture API, defaults chosen in mtb_trace.h
+  #include <mtb_trace.h>
+
   // Allow for MTB buffer size being set by define set via command line
   // Otherwise provide small default buffer
   #if !defined (__MTB_BUFFER_SIZE)
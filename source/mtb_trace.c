@@ -0,0 +1,148 @@
+/*
+ * @file mtb_trace.c
+ *
+ * @brief	MTB register handling for mtb_trace.h
+ *
+ * The trace RAM is the __mtb_buffer__ array that mtb.c reserves. MTB->POSITION
+ * holds the write offset from MTB->BASE, the low bits wrap inside the buffer as
+ * selected by MASTER.MASK (buffer size = 2^(MASK+4)).
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <mtb_trace.h>
+#include "MKL25Z4.h"
+
+static volatile bool trace_requested;
+
+#if !defined (__MTB_DISABLE) && (__MTB_BUFFER_SIZE > 0)
+
+// reserved by mtb.c through __CR_MTB_BUFFER()
+extern uint8_t __mtb_buffer__[];
+
+// MASTER.MASK for the configured buffer size
+static uint32_t mtb_mask() {
+  uint32_t mask = 0;
+  while ((16U << mask) < __MTB_BUFFER_SIZE) {
+    ++mask;
+  }
+  return mask;
+}
+
+// byte offset of the buffer from the MTB base address
+static uint32_t mtb_offset() {
+  return (uint32_t)__mtb_buffer__ - (MTB->BASE & MTB_BASE_BASEADDR_MASK);
+}
+
+// see .h for more details
+void mtb_trace_start(bool stop_when_full) {
+
+  MTB->MASTER &= ~MTB_MASTER_EN_MASK;
+
+  // rewind to the start of our buffer
+  MTB->POSITION = mtb_offset() & MTB_POSITION_POINTER_MASK;
+
+  // AUTOSTOP when the pointer reaches the last packet slot
+  if (stop_when_full) {
+    MTB->FLOW = MTB_FLOW_WATERMARK((mtb_offset() + __MTB_BUFFER_SIZE - sizeof(mtb_packet_t)) >> 3) |
+                MTB_FLOW_AUTOSTOP_MASK;
+  } else {
+    MTB->FLOW = 0;
+  }
+
+  MTB->MASTER = MTB_MASTER_EN_MASK | MTB_MASTER_MASK(mtb_mask());
+}
+
+// see .h for more details
+void mtb_trace_stop() {
+  MTB->MASTER &= ~MTB_MASTER_EN_MASK;
+}
+
+// oldest packet index and number of valid packets in the ring
+static uint32_t mtb_ring_range(uint32_t* first) {
+
+  uint32_t position = MTB->POSITION;
+  uint32_t next = ((position & MTB_POSITION_POINTER_MASK) & (__MTB_BUFFER_SIZE - 1)) / sizeof(mtb_packet_t);
+
+  // after a wrap the oldest packet is the one about to be overwritten
+  if (position & MTB_POSITION_WRAP_MASK) {
+    *first = next;
+    return MTB_TRACE_MAX_PACKETS;
+  }
+  *first = 0;
+  return next;
+}
+
+// see .h for more details
+uint32_t mtb_trace_snapshot(mtb_packet_t* dst, uint32_t max_packets) {
+
+  if (dst == NULL) return 0;
+
+  const mtb_packet_t* ring = (const mtb_packet_t*)__mtb_buffer__;
+  uint32_t first;
+  uint32_t count = mtb_ring_range(&first);
+
+  if (count > max_packets) {
+    // keep the newest packets
+    first = (first + count - max_packets) % MTB_TRACE_MAX_PACKETS;
+    count = max_packets;
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    dst[i] = ring[(first + i) % MTB_TRACE_MAX_PACKETS];
+  }
+  return count;
+}
+
+// see .h for more details, reads the ring in place to keep the stack small
+void mtb_trace_dump() {
+
+  const mtb_packet_t* ring = (const mtb_packet_t*)__mtb_buffer__;
+  uint32_t first;
+  uint32_t count = mtb_ring_range(&first);
+
+  printf("MTB begin %lu\r\n", (unsigned long)count);
+  for (uint32_t i = 0; i < count; i++) {
+    const mtb_packet_t* packet = &ring[(first + i) % MTB_TRACE_MAX_PACKETS];
+    printf("MTB %08lx %08lx\r\n", (unsigned long)packet->src, (unsigned long)packet->dst);
+  }
+  printf("MTB end\r\n");
+}
+
+#else
+
+void mtb_trace_start(bool stop_when_full) {
+  (void)stop_when_full;
+}
+
+void mtb_trace_stop() {
+}
+
+uint32_t mtb_trace_snapshot(mtb_packet_t* dst, uint32_t max_packets) {
+  (void)dst;
+  (void)max_packets;
+  return 0;
+}
+
+void mtb_trace_dump() {
+  printf("MTB begin 0\r\nMTB end\r\n");
+}
+
+#endif // !defined (__MTB_DISABLE) && (__MTB_BUFFER_SIZE > 0)
+
+// see .h for more details
+void mtb_trace_request() {
+  trace_requested = true;
+}
+
+// see .h for more details
+bool mtb_trace_take_request() {
+  if (!trace_requested) return false;
+  trace_requested = false;
+  return true;
+}
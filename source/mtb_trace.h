@@ -0,0 +1,96 @@
+/*
+ * @file mtb_trace.h
+ *
+ * @brief	On-demand capture of the Micro Trace Buffer (MTB) around one frame
+ *
+ * The Cortex-M0+ MTB writes one 8 byte packet per taken branch into a slice of
+ * SRAM: the branch source address followed by its destination. Starting it just
+ * before dsp_fft_mag() and stopping it after leaves the branch history of the
+ * FFT in RAM, mtb_trace_dump() prints it and tools/mtb_decode.py folds it
+ * against the .axf symbols into a hot function / hot loop report.
+ *
+ * Build options (Project Properties -> C/C++ Build -> Settings -> Preprocessor):
+ * 	__MTB_BUFFER_SIZE  trace RAM in bytes, a power of two >= 16. The buffer is
+ * 	                   aligned to its size, 128 by default, 1024 with MTB_TRACE_FRAMES
+ * 	__MTB_RAM_BANK     place the buffer in a specific RAM bank (see mtb.c)
+ * 	__MTB_DISABLE      no buffer, every call below becomes a no-op
+ * 	MTB_TRACE_FRAMES   main() captures and dumps one frame on request
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _MTB_TRACE_H_
+#define _MTB_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if !defined (__MTB_BUFFER_SIZE)
+  #if defined (MTB_TRACE_FRAMES)
+    #define __MTB_BUFFER_SIZE 1024
+  #else
+    #define __MTB_BUFFER_SIZE 128
+  #endif
+#endif
+
+#if (__MTB_BUFFER_SIZE > 0) && ((__MTB_BUFFER_SIZE < 16) || (__MTB_BUFFER_SIZE & (__MTB_BUFFER_SIZE - 1)))
+  #error "__MTB_BUFFER_SIZE must be a power of two and at least 16 bytes"
+#endif
+
+// one packet per taken branch: source and destination address
+typedef struct {
+  uint32_t src;   // bit 0 set if the branch was an exception entry/return
+  uint32_t dst;   // bit 0 set on the first packet after tracing started
+} mtb_packet_t;
+
+#define MTB_TRACE_MAX_PACKETS (__MTB_BUFFER_SIZE / sizeof(mtb_packet_t))
+
+/* @brief   Clears the buffer and starts recording branches
+ *
+ * @param   stop_when_full, true  = keep the first packets after the start (AUTOSTOP)
+ *                          false = wrap and keep the most recent packets
+ * @return  none
+ */
+void mtb_trace_start(bool stop_when_full);
+
+/* @brief   Stops recording, the buffer keeps its contents
+ *
+ * @param   none
+ * @return  none
+ */
+void mtb_trace_stop();
+
+/* @brief   Copies the recorded packets out oldest first
+ *
+ * @param   dst, destination array
+ *          max_packets, capacity of dst
+ * @return  number of packets copied
+ */
+uint32_t mtb_trace_snapshot(mtb_packet_t* dst, uint32_t max_packets);
+
+/* @brief   Prints the recorded packets, oldest first, as "MTB <src> <dst>" lines
+ *
+ * The lines are what tools/mtb_decode.py reads from a console log.
+ *
+ * @param   none
+ * @return  none
+ */
+void mtb_trace_dump();
+
+/* @brief   Asks the main loop to trace the next frame
+ *
+ * @param   none
+ * @return  none
+ */
+void mtb_trace_request();
+
+/* @brief   Consumes a pending trace request
+ *
+ * @param   none
+ * @return  true once per mtb_trace_request()
+ */
+bool mtb_trace_take_request();
+
+#endif // _MTB_TRACE_H_
@@ -0,0 +1,116 @@
+/*
+ * @file note_tracker.c
+ *
+ * @brief	Streaming note tracker, see note_tracker.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <note_tracker.h>
+
+// the largest lead two states can have, confidence 100
+#define NOTE_TRACK_LEAD_MAX (NOTE_TRACK_SWITCH + NOTE_TRACK_HIT)
+
+// confidence of a lead without a divide, NOTE_TRACK_LEAD_MAX is 20
+static uint8_t note_tracker_confidence(int32_t lead) {
+  if (lead >= NOTE_TRACK_LEAD_MAX) {
+    return 100;
+  }
+  return (uint8_t)(lead * 5);
+}
+
+// see .h for more details
+void note_tracker_init(note_tracker_t* t) {
+  for (uint32_t s = 0; s < NOTE_TRACK_STATES; s++) {
+    t->score[s] = -NOTE_TRACK_SWITCH;
+  }
+  t->score[NOTE_TRACK_SILENCE] = 0;
+  t->note = NOTE_TRACK_SILENCE;
+  t->candidate = NOTE_TRACK_SILENCE;
+  t->held = 0;
+  t->confidence = 0;
+}
+
+// what the frame says about state s
+static int32_t note_tracker_emit(uint32_t s, uint32_t bin, bool voiced) {
+  if (!voiced) {
+    return (s == NOTE_TRACK_SILENCE) ? NOTE_TRACK_HIT : 0;
+  }
+  if (s == NOTE_TRACK_SILENCE) {
+    return 0;
+  }
+  if (s == bin) {
+    return NOTE_TRACK_HIT;
+  }
+  if (s + 1 == bin || s == bin + 1) {
+    return NOTE_TRACK_NEAR;
+  }
+  if (s == 2 * bin || 2 * s == bin) {
+    return NOTE_TRACK_OCTAVE;
+  }
+  return 0;
+}
+
+// see .h for more details
+uint32_t note_tracker_update(note_tracker_t* t, uint16_t bin, bool voiced, note_event_t events[2]) {
+  if (bin == 0 || bin >= NOTE_TRACK_STATES) {
+    voiced = false;
+  }
+
+  // the scores are relative to the last best, which is 0
+  int32_t best = INT32_MIN, second = INT32_MIN;
+  uint32_t best_state = NOTE_TRACK_SILENCE;
+  for (uint32_t s = 0; s < NOTE_TRACK_STATES; s++) {
+    int32_t prev = t->score[s];
+    if (prev < -NOTE_TRACK_SWITCH) {
+      prev = -NOTE_TRACK_SWITCH;
+    }
+    int32_t score = prev + note_tracker_emit(s, bin, voiced);
+    t->score[s] = (int8_t)score;
+    if (score > best) {
+      second = best;
+      best = score;
+      best_state = s;
+    } else if (score > second) {
+      second = score;
+    }
+  }
+  for (uint32_t s = 0; s < NOTE_TRACK_STATES; s++) {
+    t->score[s] = (int8_t)(t->score[s] - best);
+  }
+  t->confidence = note_tracker_confidence(best - second);
+
+  // hysteresis: a new best state has to stay best for NOTE_TRACK_HOLD frames
+  if (best_state == t->note) {
+    t->held = 0;
+    return 0;
+  }
+  if (best_state != t->candidate) {
+    t->candidate = (uint8_t)best_state;
+    t->held = 0;
+  }
+  if (++t->held < NOTE_TRACK_HOLD) {
+    return 0;
+  }
+
+  uint32_t n = 0;
+  if (t->note != NOTE_TRACK_SILENCE) {
+    events[n].type = NOTE_EVENT_OFF;
+    events[n].bin = t->note;
+    events[n].confidence = t->confidence;
+    n++;
+  }
+  if (best_state != NOTE_TRACK_SILENCE) {
+    events[n].type = NOTE_EVENT_ON;
+    events[n].bin = (uint8_t)best_state;
+    events[n].confidence = t->confidence;
+    n++;
+  }
+  t->note = (uint8_t)best_state;
+  t->held = 0;
+  return n;
+}
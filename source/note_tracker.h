@@ -0,0 +1,97 @@
+/*
+ * @file note_tracker.h
+ *
+ * @brief	Streaming note tracker over the per-frame pitch bin, with note-on and
+ * 			note-off events instead of one guess per frame
+ *
+ * A small HMM over NOTE_TRACK_STATES states: silence plus one state per FFT bin
+ * 1 .. NOTE_TRACK_STATES - 1. Each frame is decoded online, Viterbi style, in
+ * integer log scores:
+ *
+ * 	score'[s] = emit(s) + max(score[s], best - NOTE_TRACK_SWITCH)
+ *
+ * Staying in a state is free and moving to any other costs NOTE_TRACK_SWITCH.
+ * Because that cost is the same for every pair, the max over all predecessors
+ * is just the best previous score, so one frame is O(states). A voiced frame
+ * gives its bin NOTE_TRACK_HIT, the bins next to it NOTE_TRACK_NEAR, and
+ * its octaves (2x and x/2) NOTE_TRACK_OCTAVE. One frame between neighbours,
+ * or an octave slip at an onset, then does not change the note. An unvoiced
+ * frame gives silence NOTE_TRACK_HIT. After each frame the scores are shifted
+ * so the best is 0. Nothing falls below -(NOTE_TRACK_SWITCH + NOTE_TRACK_HIT),
+ * so an int8_t per state is enough.
+ *
+ * Confidence is the lead of the best state over the runner-up, scaled to
+ * 0-100. For hysteresis, a new best state must also stay best for
+ * NOTE_TRACK_HOLD frames before it becomes the note. A note change gives
+ * note-off for the old note, then note-on for the new one. Bins at or above
+ * NOTE_TRACK_STATES count as unvoiced.
+ *
+ * Build options:
+ * 	NOTE_TRACK_STATES   silence + tracked bins (default 33, the default search_bins + 1)
+ * 	NOTE_TRACK_HOLD     frames a new note must lead before it is reported (default 2)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _NOTE_TRACKER_H_
+#define _NOTE_TRACKER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef NOTE_TRACK_STATES
+#define NOTE_TRACK_STATES (33)
+#endif
+
+#ifndef NOTE_TRACK_HOLD
+#define NOTE_TRACK_HOLD (2)
+#endif
+
+// log score units
+#define NOTE_TRACK_HIT     (8)
+#define NOTE_TRACK_NEAR    (4)
+#define NOTE_TRACK_OCTAVE  (3)
+#define NOTE_TRACK_SWITCH  (12)
+
+// the silence state, also the note while nothing is playing
+#define NOTE_TRACK_SILENCE (0)
+
+typedef enum {
+  NOTE_EVENT_OFF = 0,
+  NOTE_EVENT_ON
+} note_event_type_t;
+
+typedef struct {
+  uint8_t type;             // note_event_type_t
+  uint8_t bin;              // FFT bin of the note
+  uint8_t confidence;       // 0-100, at note-on; at note-off the new best state's
+} note_event_t;
+
+typedef struct {
+  int8_t score[NOTE_TRACK_STATES];
+  uint8_t note;             // reported note, NOTE_TRACK_SILENCE if none
+  uint8_t candidate;        // best state waiting out NOTE_TRACK_HOLD
+  uint8_t held;             // frames the candidate has been best
+  uint8_t confidence;       // of the last frame, 0-100
+} note_tracker_t;
+
+/* @brief   Starts in silence
+ *
+ * @param   t, tracker
+ * @return  none
+ */
+void note_tracker_init(note_tracker_t* t);
+
+/* @brief   Adds one frame
+ *
+ * @param   t, tracker
+ *          bin, the detector's bin for this frame
+ *          voiced, false when the frame holds no pitch (below min_magnitude)
+ *          events, room for 2: note-off of the old note, then note-on of the new one
+ * @return  number of events written, 0 to 2
+ */
+uint32_t note_tracker_update(note_tracker_t* t, uint16_t bin, bool voiced, note_event_t events[2]);
+
+#endif // _NOTE_TRACKER_H_
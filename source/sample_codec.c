@@ -0,0 +1,294 @@
+/*
+ * @file sample_codec.c
+ *
+ * @brief	IMA-ADPCM and delta + Rice block coders, see sample_codec.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sample_codec.h>
+
+#define ADPCM_MAX_INDEX (88)
+
+// IMA-ADPCM quantizer step sizes
+static const int16_t adpcm_steps[ADPCM_MAX_INDEX + 1] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+  11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+  32767
+};
+
+// step index change per code magnitude
+static const int8_t adpcm_index_step[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+// one IMA-ADPCM step: quantizes x against the predictor, both are updated
+static uint8_t adpcm_encode_sample(int32_t x, int32_t* predictor, int32_t* index) {
+  int32_t step = adpcm_steps[*index];
+  int32_t diff = x - *predictor;
+  int32_t vpdiff = step >> 3;
+  uint8_t code = 0;
+
+  if (diff < 0) {
+    code = 8;
+    diff = -diff;
+  }
+  if (diff >= step) {
+    code |= 4;
+    diff -= step;
+    vpdiff += step;
+  }
+  step >>= 1;
+  if (diff >= step) {
+    code |= 2;
+    diff -= step;
+    vpdiff += step;
+  }
+  step >>= 1;
+  if (diff >= step) {
+    code |= 1;
+    vpdiff += step;
+  }
+
+  int32_t p = (code & 8) ? *predictor - vpdiff : *predictor + vpdiff;
+  *predictor = (p > INT16_MAX) ? INT16_MAX : (p < INT16_MIN) ? INT16_MIN : p;
+
+  int32_t i = *index + adpcm_index_step[code & 7];
+  *index = (i < 0) ? 0 : (i > ADPCM_MAX_INDEX) ? ADPCM_MAX_INDEX : i;
+  return code;
+}
+
+// inverse of adpcm_encode_sample()
+static int32_t adpcm_decode_sample(uint8_t code, int32_t* predictor, int32_t* index) {
+  int32_t step = adpcm_steps[*index];
+  int32_t vpdiff = step >> 3;
+
+  if (code & 4) vpdiff += step;
+  if (code & 2) vpdiff += step >> 1;
+  if (code & 1) vpdiff += step >> 2;
+
+  int32_t p = (code & 8) ? *predictor - vpdiff : *predictor + vpdiff;
+  *predictor = (p > INT16_MAX) ? INT16_MAX : (p < INT16_MIN) ? INT16_MIN : p;
+
+  int32_t i = *index + adpcm_index_step[code & 7];
+  *index = (i < 0) ? 0 : (i > ADPCM_MAX_INDEX) ? ADPCM_MAX_INDEX : i;
+  return *predictor;
+}
+
+// see .h for more details
+uint32_t adpcm_encode(uint16_t* samples, uint32_t n, adpcm_state_t* state) {
+  uint8_t* out = (uint8_t*)samples;
+  int32_t predictor = (int16_t)(samples[0] ^ 0x8000U);
+  int32_t index = state->index;
+  uint8_t low = 0;
+
+  // the header covers samples 0 and 1, so sample 1 is read before it is written
+  uint16_t next = samples[1];
+  out[0] = (uint8_t)predictor;
+  out[1] = (uint8_t)(predictor >> 8);
+  out[2] = (uint8_t)index;
+  out[3] = 0;
+
+  // the byte for samples i-1 and i lands at 4 + (i-2)/2, always behind sample i
+  for (uint32_t i = 1; i < n; i++) {
+    int32_t x = (int16_t)(next ^ 0x8000U);
+    if (i + 1 < n) {
+      next = samples[i + 1];
+    }
+    uint8_t code = adpcm_encode_sample(x, &predictor, &index);
+    if (i & 1) {
+      low = code;
+    } else {
+      out[ADPCM_HEADER_BYTES + ((i - 2) >> 1)] = (uint8_t)(low | (code << 4));
+    }
+  }
+  if ((n & 1) == 0) {
+    // n-1 codes, the last byte is half full
+    out[ADPCM_HEADER_BYTES + ((n - 2) >> 1)] = low;
+  }
+
+  state->predictor = (int16_t)predictor;
+  state->index = (uint8_t)index;
+  return ADPCM_BYTES(n);
+}
+
+// see .h for more details
+uint32_t adpcm_decode(const uint8_t* block, uint32_t len, uint16_t* out, uint32_t n) {
+  if (len < ADPCM_HEADER_BYTES || n == 0) {
+    return 0;
+  }
+  int32_t predictor = (int16_t)(block[0] | (block[1] << 8));
+  int32_t index = block[2];
+  if (index > ADPCM_MAX_INDEX) {
+    return 0;
+  }
+
+  out[0] = (uint16_t)(predictor ^ 0x8000U);
+  uint32_t i = 1;
+  for (uint32_t b = ADPCM_HEADER_BYTES; b < len && i < n; b++) {
+    out[i++] = (uint16_t)(adpcm_decode_sample(block[b] & 0x0F, &predictor, &index) ^ 0x8000U);
+    if (i < n) {
+      out[i++] = (uint16_t)(adpcm_decode_sample(block[b] >> 4, &predictor, &index) ^ 0x8000U);
+    }
+  }
+  return i;
+}
+
+// zigzag of the wrapped delta: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+static uint16_t rice_map(uint16_t x, uint16_t prev) {
+  int16_t d = (int16_t)(x - prev);
+  return (uint16_t)(((uint16_t)d << 1) ^ (uint16_t)(d >> 15));
+}
+
+static uint32_t rice_code_bits(uint16_t u, uint32_t k) {
+  uint32_t q = u >> k;
+  return (q < RICE_ESCAPE) ? q + 1 + k : RICE_ESCAPE + 16;
+}
+
+// MSB first bit packer into 16 bit words
+typedef struct {
+  uint16_t* out;
+  uint32_t acc;
+  uint32_t bits;
+} rice_writer_t;
+
+static void rice_put(rice_writer_t* w, uint32_t value, uint32_t count) {
+  w->acc = (w->acc << count) | value;
+  w->bits += count;
+  if (w->bits >= 16) {
+    w->bits -= 16;
+    *w->out++ = (uint16_t)(w->acc >> w->bits);
+    w->acc &= (1U << w->bits) - 1U;
+  }
+}
+
+// see .h for more details
+uint32_t rice_encode(uint16_t* samples, uint32_t n) {
+  uint32_t sum = 0, k = 0, bits = 4;
+  uint16_t prev = samples[0];
+
+  // k ~ log2 of the mean mapped delta
+  for (uint32_t i = 1; i < n; i++) {
+    sum += rice_map(samples[i], prev);
+    prev = samples[i];
+  }
+  while (k < 15 && ((n - 1) << (k + 1)) <= sum) {
+    k++;
+  }
+
+  // dry run: the encoder reads one sample ahead, so after sample i the
+  // stream may fill words 1..i+1 but no further, or it would overwrite
+  // a sample not yet read
+  prev = samples[0];
+  for (uint32_t i = 1; i < n; i++) {
+    bits += rice_code_bits(rice_map(samples[i], prev), k);
+    prev = samples[i];
+    if (bits > ((i + 1) << 4)) {
+      return n << 1;
+    }
+  }
+  uint32_t words = 1 + ((bits + 15) >> 4);
+  if (words >= n) {
+    return n << 1;
+  }
+
+  rice_writer_t w = { samples + 1, 0, 0 };
+  uint16_t x = samples[1];
+  prev = samples[0];
+  rice_put(&w, k, 4);
+  for (uint32_t i = 1; i < n; i++) {
+    uint16_t next = (i + 1 < n) ? samples[i + 1] : 0;
+    uint16_t u = rice_map(x, prev);
+    uint32_t q = u >> k;
+    prev = x;
+    x = next;
+    if (q < RICE_ESCAPE) {
+      // q ones and the terminating zero in one put
+      rice_put(&w, ((1U << q) - 1U) << 1, q + 1);
+      if (k) {
+        rice_put(&w, u & ((1U << k) - 1U), k);
+      }
+    } else {
+      rice_put(&w, (1U << RICE_ESCAPE) - 1U, RICE_ESCAPE);
+      rice_put(&w, u, 16);
+    }
+  }
+  if (w.bits) {
+    rice_put(&w, 0, 16 - w.bits);
+  }
+  return words << 1;
+}
+
+// MSB first bit reader over 16 bit words
+typedef struct {
+  const uint16_t* in;
+  const uint16_t* end;
+  uint32_t acc;
+  uint32_t bits;
+} rice_reader_t;
+
+static bool rice_get(rice_reader_t* r, uint32_t count, uint32_t* value) {
+  if (r->bits < count) {
+    if (r->in == r->end) {
+      return false;
+    }
+    r->acc = (r->acc << 16) | *r->in++;
+    r->bits += 16;
+  }
+  r->bits -= count;
+  *value = (r->acc >> r->bits) & ((1U << count) - 1U);
+  r->acc &= (1U << r->bits) - 1U;
+  return true;
+}
+
+// see .h for more details
+bool rice_decode(const uint16_t* block, uint32_t len, uint16_t* out, uint32_t n) {
+  if (len >= (n << 1)) {
+    for (uint32_t i = 0; i < n; i++) {
+      out[i] = block[i];
+    }
+    return true;
+  }
+  if (len < 4 || n == 0) {
+    return false;
+  }
+
+  rice_reader_t r = { block + 1, block + (len >> 1), 0, 0 };
+  uint32_t k, bit, low;
+  uint16_t prev = block[0];
+
+  out[0] = prev;
+  if (!rice_get(&r, 4, &k)) {
+    return false;
+  }
+  for (uint32_t i = 1; i < n; i++) {
+    uint32_t q = 0, u;
+    do {
+      if (!rice_get(&r, 1, &bit)) {
+        return false;
+      }
+      q += bit;
+    } while (bit && q < RICE_ESCAPE);
+
+    if (q == RICE_ESCAPE) {
+      if (!rice_get(&r, 16, &u)) {
+        return false;
+      }
+    } else {
+      low = 0;
+      if (k && !rice_get(&r, k, &low)) {
+        return false;
+      }
+      u = (q << k) | low;
+    }
+    prev = (uint16_t)(prev + (uint16_t)((u >> 1) ^ (0U - (u & 1U))));
+    out[i] = prev;
+  }
+  return true;
+}
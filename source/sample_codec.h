@@ -0,0 +1,98 @@
+/*
+ * @file sample_codec.h
+ *
+ * @brief	In-place compression of one ADC block: IMA-ADPCM (lossy, 4:1) and
+ * 			delta + Rice (lossless)
+ *
+ * Both encoders work on the get_samples() buffer itself. The output never
+ * overtakes the samples still to be read, so no second buffer is needed. The
+ * decoders write to a separate buffer and also build on the host
+ * (tools/host/replay_frames.c, tools/telemetry.py has the same formats in
+ * Python).
+ *
+ * ADPCM block, 4 + n/2 bytes (260 for 512 samples):
+ * 	sample 0 as int16 (2) | step index (1) | 0 (1) | n-1 codes, 2 per byte, low nibble first
+ * 	Standard IMA step and index tables. The block header carries the state,
+ * 	so each block decodes on its own. The step index carries over from one
+ * 	block to the next in adpcm_state_t.
+ *
+ * Rice block, 16 bit words:
+ * 	sample 0 (1 word) | bit stream, MSB first: k (4) | a code per sample 1..n-1
+ * 	Each delta x[i] - x[i-1] (mod 2^16) is zigzag mapped to u and sent as
+ * 	u >> k in unary (ones ended by a zero) plus the low k bits. A quotient of
+ * 	RICE_ESCAPE or more is sent as RICE_ESCAPE ones and then u in 16 bits.
+ * 	k comes from the block's mean |delta| with shifts, not a divide. A block
+ * 	that would not get smaller is left as it is, and the encoder returns 2n
+ * 	bytes, which the decoder reads as raw samples.
+ *
+ * Neither coder divides, so both suit the M0+. The cycle counts in capture_log
+ * stats show the per-frame cost.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _SAMPLE_CODEC_H_
+#define _SAMPLE_CODEC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADPCM_HEADER_BYTES (4U)
+#define ADPCM_BYTES(n) (ADPCM_HEADER_BYTES + ((n) >> 1))
+
+// unary quotients this long switch to a 16 bit literal
+#define RICE_ESCAPE (16U)
+
+// codec_t, how an ADC block is stored
+typedef enum {
+  CODEC_RAW   = 0,
+  CODEC_ADPCM = 1,
+  CODEC_RICE  = 2
+} codec_t;
+
+// ADPCM state carried from block to block
+typedef struct {
+  int16_t predictor;    // last reconstructed sample, signed
+  uint8_t index;        // step table index, 0..88
+} adpcm_state_t;
+
+/* @brief   IMA-ADPCM encodes a block in place
+ *
+ * @param   samples, n unsigned 16 bit ADC samples, overwritten with the block
+ *          n, number of samples, at least 2
+ *          state, step index to start from, updated for the next block
+ * @return  block size in bytes, ADPCM_BYTES(n)
+ */
+uint32_t adpcm_encode(uint16_t* samples, uint32_t n, adpcm_state_t* state);
+
+/* @brief   Decodes an ADPCM block
+ *
+ * @param   block, encoded bytes
+ *          len, bytes in block
+ *          out, receives the samples
+ *          n, samples wanted
+ * @return  samples decoded, less than n if the block is short
+ */
+uint32_t adpcm_decode(const uint8_t* block, uint32_t len, uint16_t* out, uint32_t n);
+
+/* @brief   Delta + Rice encodes a block in place, losslessly
+ *
+ * @param   samples, n unsigned 16 bit ADC samples, overwritten with the block
+ *          n, number of samples, at least 2
+ * @return  block size in bytes, always even; 2n means it was left uncompressed
+ */
+uint32_t rice_encode(uint16_t* samples, uint32_t n);
+
+/* @brief   Decodes a Rice block
+ *
+ * @param   block, encoded 16 bit words
+ *          len, bytes in block, 2n for a raw block
+ *          out, receives the samples
+ *          n, samples in the block
+ * @return  false if the bit stream ends early
+ */
+bool rice_decode(const uint16_t* block, uint32_t len, uint16_t* out, uint32_t n);
+
+#endif // _SAMPLE_CODEC_H_
@@ -0,0 +1,192 @@
+/*
+ * @file scheduler.c
+ *
+ * @brief	Run-to-completion scheduler, see scheduler.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "MKL25Z4.h"
+#include "fsl_smc.h"
+#include <cpu_cycles.h>
+#include <scheduler.h>
+
+#if (SCHED_QUEUE_SIZE & (SCHED_QUEUE_SIZE - 1)) != 0
+#error "SCHED_QUEUE_SIZE must be a power of two"
+#endif
+
+// SPSC ring: the producer owns head, sched_run_once() owns tail
+typedef struct {
+  uint8_t events[SCHED_QUEUE_SIZE];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+} sched_ring_t;
+
+typedef struct {
+  sched_ring_t isr;
+  sched_ring_t task;
+  sched_handler_t handler;
+  uint32_t min_slack;
+  sched_stats_t stats;
+} sched_tcb_t;
+
+static sched_tcb_t tasks[SCHED_TASKS];
+static uint32_t (*slack_source)();
+static uint32_t sleeps;
+
+// ISR side counters, written only by the producer and added up in sched_get_stats()
+static volatile uint32_t isr_posts[SCHED_TASKS];
+static volatile uint32_t isr_dropped[SCHED_TASKS];
+
+// producer side, called by exactly one context per ring
+static bool sched_ring_put(sched_ring_t* ring, uint8_t event) {
+  uint32_t head = ring->head;
+
+  if (head - ring->tail == SCHED_QUEUE_SIZE) {
+    return false;
+  }
+  ring->events[head & (SCHED_QUEUE_SIZE - 1)] = event;
+  // event visible before the new head
+  __DMB();
+  ring->head = head + 1;
+  return true;
+}
+
+// consumer side
+static bool sched_ring_get(sched_ring_t* ring, uint8_t* event) {
+  uint32_t tail = ring->tail;
+
+  if (tail == ring->head) {
+    return false;
+  }
+  *event = ring->events[tail & (SCHED_QUEUE_SIZE - 1)];
+  // slot read before the producer may reuse it
+  __DMB();
+  ring->tail = tail + 1;
+  return true;
+}
+
+static bool sched_ring_empty(const sched_ring_t* ring) {
+  return ring->tail == ring->head;
+}
+
+// see .h for more details
+void sched_register(sched_task_t task, sched_handler_t handler, uint32_t min_slack) {
+  tasks[task].min_slack = min_slack;
+  tasks[task].handler = handler;
+}
+
+// see .h for more details
+void sched_set_slack_source(uint32_t (*slack)()) {
+  slack_source = slack;
+}
+
+// see .h for more details
+bool sched_post_isr(sched_task_t task, uint8_t event) {
+  if (!sched_ring_put(&tasks[task].isr, event)) {
+    isr_dropped[task]++;
+    return false;
+  }
+  isr_posts[task]++;
+  return true;
+}
+
+// see .h for more details
+bool sched_post(sched_task_t task, uint8_t event) {
+  if (!sched_ring_put(&tasks[task].task, event)) {
+    tasks[task].stats.dropped++;
+    return false;
+  }
+  tasks[task].stats.posts++;
+  return true;
+}
+
+// highest priority task with an event it may run now, SCHED_TASKS if none
+static uint32_t sched_pick(bool count) {
+  uint32_t slack = UINT32_MAX;
+
+  for (uint32_t t = 0; t < SCHED_TASKS; t++) {
+    sched_tcb_t* tcb = &tasks[t];
+    if (tcb->handler == NULL || (sched_ring_empty(&tcb->isr) && sched_ring_empty(&tcb->task))) {
+      continue;
+    }
+    if (tcb->min_slack && slack_source != NULL) {
+      // read once per pass, it only shrinks until the DSP task swaps buffers
+      if (slack == UINT32_MAX) {
+        slack = slack_source();
+      }
+      if (slack < tcb->min_slack) {
+        tcb->stats.deferred += count;
+        continue;
+      }
+    }
+    return t;
+  }
+  return SCHED_TASKS;
+}
+
+// see .h for more details
+bool sched_run_once() {
+  uint32_t t = sched_pick(true);
+
+  if (t == SCHED_TASKS) {
+    // interrupts stay masked from the last check to WFI so a post in
+    // between still wakes the core, its ISR runs after __enable_irq()
+    __disable_irq();
+    if (sched_pick(false) == SCHED_TASKS) {
+      sleeps++;
+      SMC_SetPowerModeWait(SMC);
+    }
+    __enable_irq();
+    return false;
+  }
+
+  sched_tcb_t* tcb = &tasks[t];
+  uint8_t event;
+  if (!sched_ring_get(&tcb->isr, &event) && !sched_ring_get(&tcb->task, &event)) {
+    return false;
+  }
+
+  uint32_t start = cpu_cycles_now();
+  tcb->handler(event);
+  uint32_t cycles = cpu_cycles_since(start);
+
+  tcb->stats.runs++;
+  tcb->stats.cycles_total += cycles;
+  if (cycles > tcb->stats.cycles_max) {
+    tcb->stats.cycles_max = cycles;
+  }
+  return true;
+}
+
+// see .h for more details
+void sched_run() {
+  for (;;) {
+    sched_run_once();
+  }
+}
+
+// see .h for more details
+void sched_get_stats(sched_task_t task, sched_stats_t* stats) {
+  *stats = tasks[task].stats;
+  stats->posts += isr_posts[task];
+  stats->dropped += isr_dropped[task];
+}
+
+// see .h for more details
+uint32_t sched_sleeps() {
+  return sleeps;
+}
+
+// see .h for more details
+const char* sched_task_name(uint32_t task) {
+  static const char* const names[SCHED_TASKS] = {
+    "dsp", "touch", "led", "log", "shell", "flash"
+  };
+  return (task < SCHED_TASKS) ? names[task] : "?";
+}
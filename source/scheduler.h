@@ -0,0 +1,153 @@
+/*
+ * @file scheduler.h
+ *
+ * @brief	Priority based run-to-completion scheduler that replaces the superloop
+ *
+ * Each task is a handler that runs one event to completion. Events are
+ * posted into per-task queues. sched_run() always takes the oldest event of
+ * the highest priority task that has one, so when a DSP frame is waiting it
+ * runs next. When nothing is ready the core sleeps in WAIT until an interrupt.
+ *
+ * Every task has two single-producer single-consumer rings, so no queue
+ * needs a lock or masked interrupts:
+ * 	- isr ring:   sched_post_isr(), from the one ISR that feeds the task
+ * 	              (DMA0 -> DSP, TSI0 -> TOUCH, UART0 -> SHELL)
+ * 	- task ring:  sched_post(), from other handlers (all run in thread mode)
+ * The ISR ring is drained first. A full ring drops the event and counts it.
+ *
+ * The scheduler cannot preempt a handler, so the low priority tasks carry a
+ * slack requirement: they only start while the slack source (samples left
+ * before the next ADC block, analog_samples_remaining()) reports at least
+ * their min_slack. Otherwise they stay queued until the DSP task has taken the next
+ * block, so console and flash work never delays a frame. Their handlers must
+ * also keep each run short (capture_log_service() checks the slack itself,
+ * shell_poll() takes SHELL_MAX_CHARS_PER_POLL characters).
+ *
+ * Per-task runtime: runs, posts, drops, deferrals, total and worst cycles
+ * (cpu_cycles), shown by `tasks` in the shell. SysTick stops in the stop
+ * modes, so a TOUCH run that enters standby only counts its awake time.
+ *
+ * Build options:
+ * 	SCHED_QUEUE_SIZE   events per ring, power of two (default 8)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef SCHED_QUEUE_SIZE
+#define SCHED_QUEUE_SIZE (8)
+#endif
+
+// sched_task_t, highest priority first
+typedef enum {
+  SCHED_TASK_DSP = 0,       // ADC block ready: FFT and pitch detection
+  SCHED_TASK_TOUCH,         // touch events, per-frame UI state, standby
+  SCHED_TASK_LED,           // LED changes
+  SCHED_TASK_LOG,           // pitch reports, verbose lines and telemetry on the console
+  SCHED_TASK_SHELL,         // console input
+  SCHED_TASK_FLASH,         // capture log programming
+  SCHED_TASKS
+} sched_task_t;
+
+// events, each task only looks at its own
+typedef enum {
+  SCHED_EV_FRAME = 0,       // DSP: DMA0 filled a block / others: the DSP task finished a frame
+  SCHED_EV_TOUCH,           // TOUCH: TSI0 queued a touch event
+  SCHED_EV_RX,              // SHELL: UART0 received characters
+  SCHED_EV_PITCH,           // LOG: report the detected pitch
+  SCHED_EV_LED_RECORD,      // LED: red, recording
+  SCHED_EV_LED_IDLE,        // LED: green, waiting
+  SCHED_EV_NOTE,            // LOG: note-on/note-off events are queued (note_tracker.h)
+  SCHED_EV_TUNER,           // LOG: the frame's tuner reading (tuner.h)
+  SCHED_EV_GATE             // LOG: the slider changed min_magnitude
+} sched_event_t;
+
+typedef void (*sched_handler_t)(uint8_t event);
+
+typedef struct {
+  uint32_t runs;            // handler calls
+  uint32_t posts;           // events queued
+  uint32_t dropped;         // events lost to a full ring
+  uint32_t deferred;        // times it was ready but the slack was too short
+  uint64_t cycles_total;    // core cycles in the handler
+  uint32_t cycles_max;
+} sched_stats_t;
+
+/* @brief   Installs a task handler
+ *
+ * @param   task, sched_task_t
+ *          handler, called once per event
+ *          min_slack, samples that must be left before the next ADC block
+ *                     for the handler to start, 0 always
+ * @return  none
+ */
+void sched_register(sched_task_t task, sched_handler_t handler, uint32_t min_slack);
+
+/* @brief   Sets where the slack comes from, e.g. analog_samples_remaining
+ *
+ * @param   slack, returns the samples left before the next block is due
+ * @return  none
+ */
+void sched_set_slack_source(uint32_t (*slack)());
+
+/* @brief   Queues an event from an ISR, only the one ISR that feeds the task
+ *          may call this for it
+ *
+ * @param   task, sched_task_t
+ *          event, sched_event_t
+ * @return  false if the ring was full
+ */
+bool sched_post_isr(sched_task_t task, uint8_t event);
+
+/* @brief   Queues an event from a task handler or main()
+ *
+ * @param   task, sched_task_t
+ *          event, sched_event_t
+ * @return  false if the ring was full
+ */
+bool sched_post(sched_task_t task, uint8_t event);
+
+/* @brief   Runs the highest priority ready event, or sleeps until an interrupt
+ *
+ * @param   none
+ * @return  true if a handler ran
+ */
+bool sched_run_once();
+
+/* @brief   sched_run_once() forever
+ *
+ * @param   none
+ * @return  never
+ */
+void sched_run();
+
+/* @brief   Runtime statistics of a task
+ *
+ * @param   task, sched_task_t
+ *          stats, filled in
+ * @return  none
+ */
+void sched_get_stats(sched_task_t task, sched_stats_t* stats);
+
+/* @brief   Times the core went to sleep with nothing ready
+ *
+ * @param   none
+ * @return  sleep count since reset
+ */
+uint32_t sched_sleeps();
+
+/* @brief   Name of a task for printing
+ *
+ * @param   task, sched_task_t
+ * @return  short lower case name
+ */
+const char* sched_task_name(uint32_t task);
+
+#endif // _SCHEDULER_H_
@@ -0,0 +1,488 @@
+/*
+ * @file shell.c
+ *
+ * @brief	Non-blocking command shell, see shell.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fsl_debug_console.h>
+#include <app_config.h>
+#include <dsp_fft.h>
+#include <mem_usage.h>
+#include <telemetry.h>
+#include <touch_sensor.h>
+#include <standby.h>
+#include <capture_log.h>
+#include <adc_cal.h>
+#include <analog_peripherals.h>
+#include <boot_profile.h>
+#include <dsp_bench.h>
+#include <scheduler.h>
+#include <shell.h>
+
+#define SHELL_MAX_TOKENS (4)
+
+// one runtime parameter, apply (optional) pushes a new value into its module
+typedef struct {
+  const char* name;
+  int32_t* value;
+  int32_t min;
+  int32_t max;
+  void (*apply)(int32_t value);
+} shell_param_t;
+
+// frame count when the TSI statistics were last cleared
+static uint32_t tsi_stats_frame;
+
+// shadows of the dsp_fft tunables, loaded in shell_init()
+static int32_t search_bins;
+static int32_t b5_threshold;
+
+static void apply_tsi_threshold(int32_t value) {
+  touch_set_threshold(value);
+}
+
+static void apply_tsi_scan_hz(int32_t value) {
+  touch_set_scan_rate(value);
+  tsi_stats_frame = app_config.frames;
+}
+
+static void apply_search_bins(int32_t value) {
+  dsp_fft_set_search_bins(value);
+}
+
+static void apply_b5_threshold(int32_t value) {
+  dsp_fft_set_b5_threshold((int16_t)value);
+}
+
+static const shell_param_t params[] = {
+  { "tsi_threshold", &app_config.tsi_threshold, TSI_HYSTERESIS + 1, 0xFFFF, apply_tsi_threshold },
+  { "tsi_scan_hz",   &app_config.tsi_scan_hz, 0, TSI_SCAN_HZ_MAX, apply_tsi_scan_hz },
+  { "search_bins",   &search_bins, 2, 256, apply_search_bins },
+  { "b5_threshold",  &b5_threshold, 0, 0x7FFF, apply_b5_threshold },
+  { "min_magnitude", &app_config.min_magnitude, 0, 0x7FFF, NULL },
+  { "detector",      &app_config.detector, DETECTOR_FORMANT, DETECTOR_ARGMAX, NULL },
+  { "standby_s",     &app_config.standby_s, 0, 3600, NULL },
+  { "verbosity",     &app_config.verbosity, 0, 2, NULL },
+  { "telemetry",     &app_config.telemetry, 0, 1, NULL },
+  { "codec",         &app_config.codec, CODEC_RAW, CODEC_RICE, NULL },
+  { "dc_block",      &app_config.dc_block, 0, 1, NULL },
+  { "notes",         &app_config.notes, 0, 1, NULL },
+};
+
+#define NUM_PARAMS (sizeof(params)/sizeof(params[0]))
+
+static uint8_t rx_ring[SHELL_RX_RING_SIZE];
+static char line[SHELL_LINE_SIZE];
+static uint8_t line_len;
+static bool line_overflow;
+static bool shell_running;
+static uint32_t shell_errors;
+
+static const shell_param_t* find_param(const char* name) {
+  for (uint32_t i = 0; i < NUM_PARAMS; i++) {
+    if (strcmp(params[i].name, name) == 0) {
+      return &params[i];
+    }
+  }
+  return NULL;
+}
+
+// decimal or 0x hex, no library call so nothing pulls in a divide
+static bool parse_int(const char* s, int32_t* out) {
+  bool negative = false;
+  int32_t value = 0;
+
+  if (*s == '-') {
+    negative = true;
+    s++;
+  }
+  if (*s == '\0') {
+    return false;
+  }
+  if (s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+    s += 2;
+    if (*s == '\0') {
+      return false;
+    }
+    for (; *s; s++) {
+      char c = *s;
+      if (c >= '0' && c <= '9')      value = (value << 4) | (c - '0');
+      else if (c >= 'a' && c <= 'f') value = (value << 4) | (c - 'a' + 10);
+      else if (c >= 'A' && c <= 'F') value = (value << 4) | (c - 'A' + 10);
+      else return false;
+      if (value > 0xFFFFFF) return false;
+    }
+  } else {
+    for (; *s; s++) {
+      if (*s < '0' || *s > '9') return false;
+      value = value * 10 + (*s - '0');
+      if (value > 0xFFFFFF) return false;
+    }
+  }
+  *out = negative ? -value : value;
+  return true;
+}
+
+static void print_param(const shell_param_t* p) {
+  printf("%s = %ld\r\n", p->name, (long)*p->value);
+}
+
+static bool cmd_help() {
+  printf("help | get [name] | set <name> <value> | counters | mode touch|continuous|tuner | standby\r\n"
+         "capture off|events|frames|erase | dump | calibrate | boot | bench [runs] | tasks\r\n");
+  for (uint32_t i = 0; i < NUM_PARAMS; i++) {
+    printf("  %-14s %ld..%ld\r\n", params[i].name, (long)params[i].min, (long)params[i].max);
+  }
+  return true;
+}
+
+static bool cmd_get(int argc, char** argv) {
+  if (argc == 1) {
+    for (uint32_t i = 0; i < NUM_PARAMS; i++) {
+      print_param(&params[i]);
+    }
+    return true;
+  }
+  const shell_param_t* p = find_param(argv[1]);
+  if (p == NULL) {
+    printf("unknown parameter %s\r\n", argv[1]);
+    return false;
+  }
+  print_param(p);
+  return true;
+}
+
+static bool cmd_set(int argc, char** argv) {
+  int32_t value;
+
+  if (argc != 3) {
+    printf("usage: set <name> <value>\r\n");
+    return false;
+  }
+  const shell_param_t* p = find_param(argv[1]);
+  if (p == NULL) {
+    printf("unknown parameter %s\r\n", argv[1]);
+    return false;
+  }
+  if (!parse_int(argv[2], &value) || value < p->min || value > p->max) {
+    printf("%s must be %ld..%ld\r\n", p->name, (long)p->min, (long)p->max);
+    return false;
+  }
+  *p->value = value;
+  if (p->apply != NULL) {
+    p->apply(value);
+  }
+  print_param(p);
+  return true;
+}
+
+static void print_adc_cal() {
+  static const char* const sources[] = { "none", "restored", "new", "drift", "requested", "failed" };
+  adc_cal_status_t cal;
+  adc_cal_get_status(&cal);
+  printf("adc_cal %s%s boot %lu cycles, calibration %lu cycles, drift temp %ld bandgap %ld\r\n",
+         sources[cal.source], cal.stored ? "" : " (not stored)", (unsigned long)cal.boot_cycles,
+         (unsigned long)cal.cal_cycles, (long)cal.temp_delta, (long)cal.bandgap_delta);
+}
+
+static bool cmd_counters() {
+  printf("frames %lu\r\n", (unsigned long)app_config.frames);
+  printf("console_dropped %lu\r\n", (unsigned long)DbgConsole_GetTxDroppedCount());
+  printf("telem_records %lu\r\n", (unsigned long)telem_record_count());
+  printf("stack_high_water %lu/%lu\r\n", (unsigned long)stack_high_water_mark(),
+         (unsigned long)stack_reserved());
+  // frames arrive at 8192/512 = 16 per second
+  touch_isr_stats_t tsi;
+  touch_get_isr_stats(&tsi);
+  uint32_t tsi_frames = app_config.frames - tsi_stats_frame;
+  printf("tsi_isr %lu (%lu/s) avg %lu max %lu cycles\r\n", (unsigned long)tsi.count,
+         (unsigned long)(tsi_frames ? (tsi.count * 16U) / tsi_frames : 0),
+         (unsigned long)(tsi.count ? tsi.cycles_total / tsi.count : 0),
+         (unsigned long)tsi.cycles_max);
+  standby_stats_t sb;
+  standby_get_stats(&sb);
+  printf("standby %lu resume %lu+%lu us worst %lu us\r\n", (unsigned long)sb.entries,
+         (unsigned long)sb.clock_us, (unsigned long)sb.frame_us, (unsigned long)sb.worst_us);
+  print_adc_cal();
+  analog_capacity_t adc;
+  analog_get_capacity(&adc);
+  printf("adc %lu ch at %lu.%03lu Hz (trigger %lu Hz), %lu ns per conversion, max %lu/s = %lu ch\r\n",
+         (unsigned long)adc.channels, (unsigned long)(adc.channel_mhz / 1000U),
+         (unsigned long)(adc.channel_mhz % 1000U), (unsigned long)adc.trigger_hz,
+         (unsigned long)adc.conversion_ns, (unsigned long)adc.max_rate, (unsigned long)adc.max_channels);
+#if ANALOG_OVERSAMPLE > 1
+  // 512 / 64 DMA blocks per frame
+  analog_decimate_stats_t dec;
+  analog_get_decimate_stats(&dec);
+  printf("decimate %ux avg %lu max %lu cycles per block, %lu per frame\r\n", ANALOG_OVERSAMPLE,
+         (unsigned long)(dec.blocks ? dec.cycles_total / dec.blocks : 0), (unsigned long)dec.cycles_max,
+         (unsigned long)(dec.blocks ? (dec.cycles_total * 8U) / dec.blocks : 0));
+#endif
+  printf("touch_events_dropped %lu\r\n", (unsigned long)touch_events_dropped());
+  printf("shell_errors %lu\r\n", (unsigned long)shell_errors);
+  return true;
+}
+
+static bool cmd_mode(int argc, char** argv) {
+  if (argc == 2 && strcmp(argv[1], "touch") == 0) {
+    app_config.mode = MODE_TOUCH;
+  } else if (argc == 2 && strcmp(argv[1], "continuous") == 0) {
+    app_config.mode = MODE_CONTINUOUS;
+  } else if (argc == 2 && strcmp(argv[1], "tuner") == 0) {
+    app_config.mode = MODE_TUNER;
+  } else if (argc != 1) {
+    printf("usage: mode touch|continuous|tuner\r\n");
+    return false;
+  }
+  printf("mode %s\r\n", app_config.mode == MODE_TOUCH ? "touch" :
+                         app_config.mode == MODE_CONTINUOUS ? "continuous" : "tuner");
+  return true;
+}
+
+static bool cmd_standby() {
+  printf("standby, touch to wake\r\n");
+  if (!standby_enter()) {
+    printf("stop mode refused\r\n");
+    return false;
+  }
+  printf("awake\r\n");
+  return true;
+}
+
+static bool cmd_capture(int argc, char** argv) {
+  static const char* const modes[] = { "off", "events", "frames" };
+
+  if (argc == 2 && strcmp(argv[1], "erase") == 0) {
+    // several 14 ms erases back to back, sampling stops meanwhile
+    capture_log_erase();
+  } else if (argc == 2) {
+    int32_t m;
+    for (m = CAPTURE_OFF; m <= CAPTURE_FRAMES; m++) {
+      if (strcmp(argv[1], modes[m]) == 0) break;
+    }
+    if (m > CAPTURE_FRAMES) {
+      printf("usage: capture off|events|frames|erase\r\n");
+      return false;
+    }
+    app_config.capture = m;
+  } else if (argc != 1) {
+    printf("usage: capture off|events|frames|erase\r\n");
+    return false;
+  }
+
+  capture_stats_t cs;
+  capture_log_get_stats(&cs);
+  printf("capture %s, %lu records, %lu/%lu bytes, %lu erases, %lu laps, %lu dropped, %lu skipped\r\n",
+         modes[app_config.capture], (unsigned long)cs.records, (unsigned long)cs.used_bytes,
+         (unsigned long)cs.size_bytes, (unsigned long)cs.erases, (unsigned long)cs.laps,
+         (unsigned long)cs.dropped, (unsigned long)cs.skipped_frames);
+  printf("codec %ld, last frame %lu bytes in %lu cycles (max %lu)\r\n", (long)app_config.codec,
+         (unsigned long)cs.frame_bytes, (unsigned long)cs.encode_cycles, (unsigned long)cs.encode_cycles_max);
+  return true;
+}
+
+static bool cmd_dump() {
+  // binary TELEM_CAPTURE frames, decode with tools/telem_decode.py --type capture
+  uint32_t n = capture_log_dump();
+  printf("\r\ndumped %lu records\r\n", (unsigned long)n);
+  return true;
+}
+
+static bool cmd_calibrate() {
+  // the ADC has to be in software trigger mode, no frames meanwhile
+  analog_stop();
+  bool ok = adc_cal_run();
+  analog_restart();
+  print_adc_cal();
+  return ok;
+}
+
+static bool cmd_boot() {
+  uint32_t n, at_us = 0;
+  const boot_record_t* r = boot_profile_get(&n);
+
+  if (n == 0) {
+    printf("no boot profile\r\n");
+    return false;
+  }
+  // at_us is the end of the phase counted from reset
+  for (uint32_t i = 0; i < n; i++) {
+    at_us += r[i].us;
+    printf("%-12s %8lu cycles @ %2lu MHz %7lu us  at %7lu us\r\n", boot_phase_name(r[i].phase),
+           (unsigned long)r[i].cycles, (unsigned long)(r[i].hz / 1000000U),
+           (unsigned long)r[i].us, (unsigned long)at_us);
+  }
+  return true;
+}
+
+static bool cmd_bench(int argc, char** argv) {
+  static const char* const modes[] = { "cache on", "cache off" };
+  int32_t runs = 16;
+  dsp_bench_result_t r[DSP_BENCH_MODES];
+  dsp_bench_placement_t where;
+
+  if (argc > 2 || (argc == 2 && (!parse_int(argv[1], &runs) || runs < 1 || runs > DSP_BENCH_MAX_RUNS))) {
+    printf("usage: bench [1..%d]\r\n", DSP_BENCH_MAX_RUNS);
+    return false;
+  }
+  // the last block again, no DMA on the bus meanwhile
+  analog_stop();
+  bool ok = dsp_bench_run(analog_last_samples(), runs, r);
+  analog_restart();
+  if (!ok) {
+    return false;
+  }
+
+  dsp_bench_placement(&where);
+  printf("dsp_fft_mag %s, cmsis fft %s, twiddles %s\r\n", where.fft_mag ? "sram" : "flash",
+         where.cmsis ? "sram" : "flash", where.tables ? "sram" : "flash");
+  for (uint32_t m = 0; m < DSP_BENCH_MODES; m++) {
+    printf("%-9s min %7lu avg %7lu max %7lu cycles\r\n", modes[m], (unsigned long)r[m].min,
+           (unsigned long)r[m].avg, (unsigned long)r[m].max);
+  }
+  return true;
+}
+
+static bool cmd_tasks() {
+  // frames come every 512/8192 s, so cycles per frame show the load
+  uint32_t frames = app_config.frames ? app_config.frames : 1;
+  printf("task      runs    posts dropped deferred  cyc/frame    max cyc\r\n");
+  for (uint32_t t = 0; t < SCHED_TASKS; t++) {
+    sched_stats_t st;
+    sched_get_stats(t, &st);
+    printf("%-6s %7lu %8lu %7lu %8lu %10lu %10lu\r\n", sched_task_name(t), (unsigned long)st.runs,
+           (unsigned long)st.posts, (unsigned long)st.dropped, (unsigned long)st.deferred,
+           (unsigned long)(st.cycles_total / frames), (unsigned long)st.cycles_max);
+  }
+  printf("sleeps %lu\r\n", (unsigned long)sched_sleeps());
+  return true;
+}
+
+// split the line in place on spaces and dispatch
+static void execute_line() {
+  char* argv[SHELL_MAX_TOKENS];
+  int argc = 0;
+  char* p = line;
+  bool ok;
+
+  while (*p) {
+    while (*p == ' ' || *p == '\t') *p++ = '\0';
+    if (*p == '\0') break;
+    if (argc == SHELL_MAX_TOKENS) {
+      printf("too many arguments\r\n");
+      shell_errors++;
+      return;
+    }
+    argv[argc++] = p;
+    while (*p && *p != ' ' && *p != '\t') p++;
+  }
+  if (argc == 0) {
+    return;
+  }
+
+  if (strcmp(argv[0], "help") == 0)          ok = cmd_help();
+  else if (strcmp(argv[0], "get") == 0)      ok = cmd_get(argc, argv);
+  else if (strcmp(argv[0], "set") == 0)      ok = cmd_set(argc, argv);
+  else if (strcmp(argv[0], "counters") == 0) ok = cmd_counters();
+  else if (strcmp(argv[0], "mode") == 0)     ok = cmd_mode(argc, argv);
+  else if (strcmp(argv[0], "standby") == 0)  ok = cmd_standby();
+  else if (strcmp(argv[0], "capture") == 0)  ok = cmd_capture(argc, argv);
+  else if (strcmp(argv[0], "dump") == 0)     ok = cmd_dump();
+  else if (strcmp(argv[0], "calibrate") == 0) ok = cmd_calibrate();
+  else if (strcmp(argv[0], "boot") == 0)     ok = cmd_boot();
+  else if (strcmp(argv[0], "bench") == 0)    ok = cmd_bench(argc, argv);
+  else if (strcmp(argv[0], "tasks") == 0)    ok = cmd_tasks();
+  else {
+    printf("unknown command %s, try help\r\n", argv[0]);
+    ok = false;
+  }
+  if (!ok) {
+    shell_errors++;
+  }
+}
+
+// UART0 interrupt, new characters in rx_ring
+static void shell_rx_notify() {
+  sched_post_isr(SCHED_TASK_SHELL, SCHED_EV_RX);
+}
+
+// see .h for more details
+bool shell_init() {
+  search_bins = dsp_fft_search_bins();
+  b5_threshold = dsp_fft_b5_threshold();
+  shell_running = (DbgConsole_StartRxRingBuffer(rx_ring, sizeof(rx_ring)) == kStatus_Success);
+  DbgConsole_SetRxNotify(shell_rx_notify);
+  if (shell_running) {
+    printf("> ");
+  }
+  return shell_running;
+}
+
+// see .h for more details
+bool shell_rx_pending() {
+  // the SHELL task outranks FLASH, so the ring is drained before the capture
+  // log runs and only a partial line is left to look at
+  return shell_running && (line_len > 0 || line_overflow);
+}
+
+// see .h for more details
+bool shell_poll() {
+  int ch;
+
+  if (!shell_running) {
+    return false;
+  }
+
+  for (int n = 0; n < SHELL_MAX_CHARS_PER_POLL; n++) {
+    ch = DbgConsole_TryGetchar();
+    if (ch < 0) {
+      return n > 0;
+    }
+
+    if (ch == '\r' || ch == '\n') {
+      // CR LF pairs arrive as an empty second line, which is ignored
+      if (line_len == 0 && !line_overflow) {
+        continue;
+      }
+      printf("\r\n");
+      line[line_len] = '\0';
+      if (line_overflow) {
+        printf("line too long\r\n");
+        shell_errors++;
+      } else {
+        execute_line();
+      }
+      line_len = 0;
+      line_overflow = false;
+      printf("> ");
+      // one command per call keeps the worst case to a single command's output
+      return true;
+    }
+
+    if ((ch == '\b' || ch == 0x7F) && line_len > 0) {
+      line_len--;
+      printf("\b \b");
+    } else if (ch >= ' ' && ch < 0x7F) {
+      if (line_len < SHELL_LINE_SIZE - 1) {
+        line[line_len++] = (char)ch;
+        putchar(ch);
+      } else {
+        line_overflow = true;
+      }
+    }
+  }
+  return true;
+}
+
+// see .h for more details
+uint32_t shell_error_count() {
+  return shell_errors;
+}
@@ -0,0 +1,99 @@
+/*
+ * @file shell.h
+ *
+ * @brief	Non-blocking command shell on the debug console UART
+ *
+ * UART0 receives into a ring buffer under interrupt (LPSCI_TransferStartRingBuffer
+ * through DbgConsole_StartRxRingBuffer). The interrupt posts SCHED_EV_RX and
+ * shell_poll() runs as the scheduler's SHELL task (scheduler.h), only while
+ * enough of the current ADC block is left. Each call takes at most
+ * SHELL_MAX_CHARS_PER_POLL characters and only a finished line is executed, so
+ * the shell never stalls sampling and its cost per run is bounded.
+ *
+ * commands (one per line, CR or LF terminated):
+ * 	help                      list commands and parameters
+ * 	get [name]                print one or every parameter
+ * 	set <name> <value>        change a parameter, see app_config.h
+ * 	counters                  frames, console drops, telemetry records, stack, TSI ISR rate/cost,
+ * 	                          ADC calibration source, ADC channels and capacity, touch drops,
+ * 	                          shell errors
+ * 	mode touch|continuous|tuner   report pitch once per touch, every frame, or every
+ * 	                          frame as note, octave and cents (tuner.h)
+ * 	standby                   sleep until the touch slider is touched, see standby.h
+ * 	capture off|events|frames|erase   flash capture log mode and status, see capture_log.h
+ * 	dump                      send the capture log as TELEM_CAPTURE records
+ * 	calibrate                 rerun the ADC calibration and store it, see adc_cal.h
+ * 	boot                      reset-to-first-frame time per boot phase, see boot_profile.h
+ * 	bench [runs]              FFT pipeline cycles with the flash cache on and off, see dsp_bench.h
+ * 	tasks                     scheduler runs, posts, drops, deferrals and cycles per task
+ *
+ * parameters: tsi_threshold, tsi_scan_hz, search_bins, b5_threshold, min_magnitude,
+ * standby_s, detector (0 formant, 1 argmax), verbosity (0-2), telemetry (0/1),
+ * codec (captured frames: 0 raw, 1 ADPCM, 2 Rice), dc_block (0 fixed 1<<15 bias, 1 tracked),
+ * notes (continuous mode: 0 a report per frame, 1 note-on/off events)
+ *
+ * Build options:
+ * 	SHELL_DISABLE             no shell, the console stays transmit only
+ * 	SHELL_RX_RING_SIZE        receive ring bytes (default 64)
+ * 	SHELL_LINE_SIZE           longest command line (default 48)
+ * 	SHELL_MAX_CHARS_PER_POLL  characters handled per shell_poll() (default 16)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _SHELL_H_
+#define _SHELL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef SHELL_RX_RING_SIZE
+#define SHELL_RX_RING_SIZE (64)
+#endif
+
+#ifndef SHELL_LINE_SIZE
+#define SHELL_LINE_SIZE (48)
+#endif
+
+#ifndef SHELL_MAX_CHARS_PER_POLL
+#define SHELL_MAX_CHARS_PER_POLL (16)
+#endif
+
+/* @brief   Starts receiving on the debug console UART and prints the prompt
+ *
+ * @param   none
+ * @return  true if the console supports interrupt driven receive
+ */
+bool shell_init();
+
+/* @brief   Consumes received characters and executes a completed line
+ *
+ * The SHELL task handler, it returns at once when nothing has arrived. Post
+ * the task again while it returns true, characters may be left in the ring.
+ *
+ * @param   none
+ * @return  true if any character was received (user activity)
+ */
+bool shell_poll();
+
+/* @brief   Whether a command line is being typed
+ *
+ * Flash programming masks interrupts for longer than one character at
+ * 115200 baud, and UART0 has no receive FIFO, so main() holds the capture log
+ * off while this is true. A half typed line holds it until Enter.
+ *
+ * @param   none
+ * @return  true while input is pending
+ */
+bool shell_rx_pending();
+
+/* @brief   Lines that failed to parse or execute since reset
+ *
+ * @param   none
+ * @return  error count
+ */
+uint32_t shell_error_count();
+
+#endif // _SHELL_H_
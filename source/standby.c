@@ -0,0 +1,103 @@
+/*
+ * @file standby.c
+ *
+ * @brief	Armed standby in LLS/VLPS with TSI wakeup, see standby.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "MKL25Z4.h"
+#include "fsl_smc.h"
+#include "fsl_clock.h"
+#include "fsl_debug_console.h"
+#include <analog_peripherals.h>
+#include <touch_sensor.h>
+#include <cpu_cycles.h>
+#include <standby.h>
+
+static standby_stats_t stats;
+static bool frame_pending;
+static uint32_t frame_start;
+
+// see .h for more details
+void standby_init() {
+  SMC_SetPowerModeProtection(SMC, kSMC_AllowPowerModeAll);
+
+#if !defined(STANDBY_USE_VLPS)
+  // LLWU internal module sources 0 and 4 are LPTMR0 and TSI0
+  LLWU->ME |= LLWU_ME_WUME0_MASK | LLWU_ME_WUME4_MASK;
+  NVIC_ClearPendingIRQ(LLWU_IRQn);
+  NVIC_EnableIRQ(LLWU_IRQn);
+#endif
+}
+
+// module wakeup flags clear at the source, the TSI ISR handles the scan itself
+void LLWU_IRQHandler(void) {
+  TSI0->GENCS |= TSI_GENCS_OUTRGF_MASK;
+  LPTMR0->CSR |= LPTMR_CSR_TCF_MASK;
+}
+
+// see .h for more details
+bool standby_enter() {
+  status_t status;
+  uint32_t wake, wake_hz;
+
+  analog_stop();
+  DbgConsole_Flush();
+  touch_arm_wakeup(TSI_SENSOR_CHANNEL);
+
+  // the LPTMR wakes the core every scan period to clear its compare flag,
+  // go back to sleep until a scan was out of range
+  do {
+    SMC_PreEnterStopModes();
+#if defined(STANDBY_USE_VLPS)
+    status = SMC_SetPowerModeVlps(SMC);
+#else
+    status = SMC_SetPowerModeLls(SMC);
+#endif
+    // awake: SysTick counts again, at the bypass clock until PEE is back
+    wake = cpu_cycles_now();
+    wake_hz = CLOCK_GetCoreSysClkFreq();
+    // the pending LLWU, LPTMR and TSI interrupts run here
+    SMC_PostExitStopModes();
+  } while (status == kStatus_Success && !touch_wakeup_touched());
+
+  // stop modes turn the PLL off and leave the MCG in PBE
+  if (CLOCK_GetMode() == kMCG_ModePBE) {
+    CLOCK_SetPeeMode();
+    while (CLOCK_GetMode() != kMCG_ModePEE) {;}
+  }
+  uint32_t clock_cycles = cpu_cycles_since(wake);
+
+  touch_disarm_wakeup();
+  analog_restart();
+
+  // once per wake, so the divides stay off the frame path
+  stats.clock_us = clock_cycles / (wake_hz / 1000000U);
+  stats.entries++;
+  frame_start = cpu_cycles_now();
+  frame_pending = true;
+
+  return status == kStatus_Success;
+}
+
+// see .h for more details
+void standby_frame_ready() {
+  if (!frame_pending) {
+    return;
+  }
+  frame_pending = false;
+  stats.frame_us = cpu_cycles_since(frame_start) / (SystemCoreClock / 1000000U);
+  if (stats.clock_us + stats.frame_us > stats.worst_us) {
+    stats.worst_us = stats.clock_us + stats.frame_us;
+  }
+}
+
+// see .h for more details
+void standby_get_stats(standby_stats_t* out) {
+  *out = stats;
+}
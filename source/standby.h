@@ -0,0 +1,81 @@
+/*
+ * @file standby.h
+ *
+ * @brief	Armed standby: sleep in LLS (or VLPS) until the touch slider is touched
+ *
+ * standby_enter() stops the ADC/DMA acquisition, flushes the console, arms
+ * the TSI out-of-range wakeup on TSI_SENSOR_CHANNEL and stops the core. The
+ * LPTMR keeps triggering TSI scans from the 1 kHz LPO while everything else
+ * is off. The LPTMR compare flag is the scan trigger and nothing else clears
+ * it in standby, so its interrupt (LLWU module source 0 in LLS) wakes the core
+ * every scan period to clear it, and standby_enter() goes straight back to
+ * sleep. A touch raises the TSI interrupt, routed through LLWU module source
+ * 4 (TSI0) in LLS, and the core resumes inside standby_enter(). The PLL is
+ * re-locked (the MCG comes back in PBE), the normal TSI sweep and the ADC are
+ * restarted and the call returns.
+ *
+ * Resume latency is reported in two parts:
+ * 	clock_us  wake to the PLL back in PEE, timed in SysTick cycles at the
+ * 	          bypass clock the core runs on until then
+ * 	frame_us  PEE to the first full ADC block, normally ~62.5 ms for 512
+ * 	          samples at 8192 Hz, timed when main() calls standby_frame_ready()
+ * The hardware stop-mode exit itself (a few us) is not visible to the core.
+ *
+ * Build options:
+ * 	STANDBY_USE_VLPS        VLPS instead of LLS (faster exit, more current, no LLWU)
+ * 	STANDBY_IDLE_SECONDS    untouched time before main() enters standby (default 0, never,
+ * 	                        until the touch wakeup is verified on a board; 30 is typical)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _STANDBY_H_
+#define _STANDBY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef STANDBY_IDLE_SECONDS
+#define STANDBY_IDLE_SECONDS (0)
+#endif
+
+typedef struct {
+  uint32_t entries;     // times standby was entered
+  uint32_t clock_us;    // last wake: stop mode exit to PLL locked
+  uint32_t frame_us;    // last wake: PLL locked to first ADC block
+  uint32_t worst_us;    // worst clock_us + frame_us seen
+} standby_stats_t;
+
+/* @brief   Allows the stop modes and routes the TSI and LPTMR to the LLWU
+ *
+ * @param   none
+ * @return  none
+ */
+void standby_init();
+
+/* @brief   Sleeps until the touch channel is touched, returns with clocks,
+ *          TSI and ADC acquisition running again
+ *
+ * @param   none
+ * @return  true if the stop mode was entered, false if it was refused
+ */
+bool standby_enter();
+
+/* @brief   Called by main() for every finished ADC block, closes the resume
+ *          latency measurement on the first block after a wake
+ *
+ * @param   none
+ * @return  none
+ */
+void standby_frame_ready();
+
+/* @brief   Standby counters and the last resume latency
+ *
+ * @param   stats, filled in
+ * @return  none
+ */
+void standby_get_stats(standby_stats_t* stats);
+
+#endif // _STANDBY_H_
@@ -0,0 +1,192 @@
+/*
+ * @file telemetry.c
+ *
+ * @brief	COBS framed telemetry records, see telemetry.h
+ *
+ * The COBS encoder streams: bytes collect in one 254 byte block and each
+ * block goes to the console as soon as its length code is known, so a
+ * spectrum record never needs a whole-frame buffer.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <fsl_debug_console.h>
+#include <crc16.h>
+#include <mem_usage.h>
+#include <telemetry.h>
+
+#define COBS_MAX_BLOCK (254)
+
+// one record being encoded
+typedef struct {
+  uint8_t block[COBS_MAX_BLOCK + 1];   // [0] is the length code
+  uint8_t len;                         // data bytes in block
+  uint16_t crc;
+} telem_encoder_t;
+
+static telem_encoder_t encoder;
+static uint8_t telem_seq;
+static uint32_t telem_records;
+
+static void telem_flush_block(uint8_t code) {
+  encoder.block[0] = code;
+  DbgConsole_Write(encoder.block, encoder.len + 1U);
+  encoder.len = 0;
+}
+
+static void telem_put_raw(uint8_t byte) {
+
+  if (byte == 0) {
+    telem_flush_block(encoder.len + 1U);
+    return;
+  }
+  encoder.block[1U + encoder.len++] = byte;
+  if (encoder.len == COBS_MAX_BLOCK) {
+    telem_flush_block(0xFF);
+  }
+}
+
+static void telem_put(uint8_t byte) {
+  encoder.crc = crc16_ccitt(encoder.crc, &byte, 1);
+  telem_put_raw(byte);
+}
+
+static void telem_put16(uint16_t value) {
+  telem_put((uint8_t)value);
+  telem_put((uint8_t)(value >> 8));
+}
+
+static void telem_put32(uint32_t value) {
+  telem_put16((uint16_t)value);
+  telem_put16((uint16_t)(value >> 16));
+}
+
+static void telem_begin(telem_type_t type, uint32_t frame) {
+  static const uint8_t delimiter = 0;
+
+  // leading delimiter ends any partial frame or text the host saw before
+  DbgConsole_Write(&delimiter, 1);
+  encoder.len = 0;
+  encoder.crc = CRC16_INIT;
+  telem_put((uint8_t)type);
+  telem_put(telem_seq++);
+  telem_put32(frame);
+}
+
+static void telem_end() {
+  static const uint8_t delimiter = 0;
+  uint16_t crc = encoder.crc;
+
+  telem_put_raw((uint8_t)crc);
+  telem_put_raw((uint8_t)(crc >> 8));
+  telem_flush_block(encoder.len + 1U);
+  DbgConsole_Write(&delimiter, 1);
+  telem_records++;
+}
+
+// see .h for more details
+void telem_send_pitch(uint32_t frame, uint16_t bin, int16_t magnitude) {
+  telem_begin(TELEM_PITCH, frame);
+  telem_put16(bin);
+  telem_put16((uint16_t)magnitude);
+  telem_end();
+}
+
+// see .h for more details
+void telem_send_peaks(uint32_t frame, const int16_t* mags, int nbins) {
+
+  uint16_t peak_bin[TELEM_PEAKS_K];
+  int16_t peak_mag[TELEM_PEAKS_K];
+  int k = 0;
+
+  // insertion into a short sorted list, O(nbins * K) with no divides
+  for (int i = 1; i + 1 < nbins; i++) {
+    int16_t m = mags[i];
+    if (m <= 0 || m < mags[i-1] || m <= mags[i+1]) continue;
+    if (k == TELEM_PEAKS_K && m <= peak_mag[k-1]) continue;
+
+    int j = (k < TELEM_PEAKS_K) ? k++ : k - 1;
+    while (j > 0 && peak_mag[j-1] < m) {
+      peak_mag[j] = peak_mag[j-1];
+      peak_bin[j] = peak_bin[j-1];
+      j--;
+    }
+    peak_mag[j] = m;
+    peak_bin[j] = (uint16_t)i;
+  }
+
+  telem_begin(TELEM_PEAKS, frame);
+  telem_put((uint8_t)k);
+  for (int i = 0; i < k; i++) {
+    telem_put16(peak_bin[i]);
+    telem_put16((uint16_t)peak_mag[i]);
+  }
+  telem_end();
+}
+
+// see .h for more details
+void telem_send_spectrum(uint32_t frame, const int16_t* mags, int nbins) {
+  telem_begin(TELEM_SPECTRUM, frame);
+  telem_put16((uint16_t)nbins);
+  for (int i = 0; i < nbins; i++) {
+    telem_put16((uint16_t)mags[i]);
+  }
+  telem_end();
+}
+
+// see .h for more details
+void telem_send_counters(uint32_t frames) {
+
+  uint32_t counters[TELEM_CNT_COUNT];
+  counters[TELEM_CNT_FRAMES] = frames;
+  counters[TELEM_CNT_CONSOLE_DROPPED] = DbgConsole_GetTxDroppedCount();
+  counters[TELEM_CNT_TELEM_RECORDS] = telem_records;
+  counters[TELEM_CNT_STACK_HIGH_WATER] = stack_high_water_mark();
+
+  telem_begin(TELEM_COUNTERS, frames);
+  telem_put(TELEM_CNT_COUNT);
+  for (int i = 0; i < TELEM_CNT_COUNT; i++) {
+    telem_put32(counters[i]);
+  }
+  telem_end();
+}
+
+// see .h for more details
+void telem_send_capture(uint32_t frame, uint8_t kind, const uint8_t* payload, uint16_t len) {
+  telem_begin(TELEM_CAPTURE, frame);
+  telem_put(kind);
+  for (uint16_t i = 0; i < len; i++) {
+    telem_put(payload[i]);
+  }
+  telem_end();
+}
+
+// see .h for more details
+uint32_t telem_record_count() {
+  return telem_records;
+}
+
+// see .h for more details
+void telem_frame(uint32_t frame, const int16_t* mags, int nsamples, uint16_t bin) {
+
+  // countdowns rather than frame % N, the M0+ has no divider
+  static uint32_t spectrum_countdown = TELEM_SPECTRUM_EVERY;
+  static uint32_t counters_countdown = TELEM_COUNTERS_EVERY;
+  int nbins = (nsamples >> 1) + 1;
+
+  telem_send_pitch(frame, bin, mags[bin]);
+  telem_send_peaks(frame, mags, nbins);
+
+  if (TELEM_SPECTRUM_EVERY > 0 && --spectrum_countdown == 0) {
+    spectrum_countdown = TELEM_SPECTRUM_EVERY;
+    telem_send_spectrum(frame, mags, nbins);
+  }
+  if (TELEM_COUNTERS_EVERY > 0 && --counters_countdown == 0) {
+    counters_countdown = TELEM_COUNTERS_EVERY;
+    telem_send_counters(frame + 1);
+  }
+}
@@ -0,0 +1,132 @@
+/*
+ * @file telemetry.h
+ *
+ * @brief	Binary per-frame telemetry: COBS framed, CRC-16 protected records
+ * 			on the debug console for tools/telem_decode.py
+ *
+ * frame on the wire:
+ * 	0x00 | COBS( type | seq | frame (4) | body | CRC-16/CCITT of the preceding bytes (2) ) | 0x00
+ *
+ * COBS removes every 0x00 from the record, so 0x00 only ever marks a frame
+ * boundary and the host can resync after any dropped byte. All fields are
+ * little endian. seq counts every record sent so the host can count losses.
+ *
+ * bodies:
+ * 	TELEM_PITCH     bin (2) | magnitude (2)
+ * 	TELEM_PEAKS     k (1) | k x { bin (2) | magnitude (2) }, strongest first
+ * 	TELEM_SPECTRUM  nbins (2) | nbins x magnitude (2)
+ * 	TELEM_COUNTERS  n (1) | n x counter (4), see telem_counter_t
+ * 	TELEM_CAPTURE   kind (1) | payload, one flash capture log record (capture_log.h)
+ *
+ * A 257 bin spectrum is ~530 bytes, about 46 ms at 115200 baud, so it is off
+ * by default and should go with a larger DEBUG_CONSOLE_TX_RING_SIZE.
+ *
+ * Build options:
+ * 	TELEMETRY_DISABLE       no telemetry from main()
+ * 	TELEM_PEAKS_K           peaks per TELEM_PEAKS record (default 5)
+ * 	TELEM_SPECTRUM_EVERY    send the spectrum every N frames (default 0 = never)
+ * 	TELEM_COUNTERS_EVERY    send the counters every N frames (default 64)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#include <stdint.h>
+
+#ifndef TELEM_PEAKS_K
+#define TELEM_PEAKS_K (5)
+#endif
+
+#ifndef TELEM_SPECTRUM_EVERY
+#define TELEM_SPECTRUM_EVERY (0)
+#endif
+
+#ifndef TELEM_COUNTERS_EVERY
+#define TELEM_COUNTERS_EVERY (64)
+#endif
+
+// record types, first byte of every frame
+typedef enum {
+  TELEM_PITCH    = 1,
+  TELEM_PEAKS    = 2,
+  TELEM_SPECTRUM = 3,
+  TELEM_COUNTERS = 4,
+  TELEM_CAPTURE  = 5
+} telem_type_t;
+
+// order of the words in a TELEM_COUNTERS record, append only
+typedef enum {
+  TELEM_CNT_FRAMES = 0,          // frames processed
+  TELEM_CNT_CONSOLE_DROPPED,     // bytes the console TX ring dropped
+  TELEM_CNT_TELEM_RECORDS,       // telemetry records sent
+  TELEM_CNT_STACK_HIGH_WATER,    // deepest stack use in bytes
+  TELEM_CNT_COUNT
+} telem_counter_t;
+
+/* @brief   Sends the detected pitch bin and its magnitude
+ *
+ * @param   frame, frame number the result belongs to
+ *          bin, dsp_fft_max_pitch() result
+ *          magnitude, power in that bin
+ * @return  none
+ */
+void telem_send_pitch(uint32_t frame, uint16_t bin, int16_t magnitude);
+
+/* @brief   Sends the TELEM_PEAKS_K strongest local maxima of a power spectrum
+ *
+ * @param   frame, frame number
+ *          mags, dsp_fft_mag() output
+ *          nbins, bins to search (N/2 + 1 for an N point transform)
+ * @return  none
+ */
+void telem_send_peaks(uint32_t frame, const int16_t* mags, int nbins);
+
+/* @brief   Sends a whole power spectrum
+ *
+ * @param   frame, frame number
+ *          mags, dsp_fft_mag() output
+ *          nbins, number of bins to send
+ * @return  none
+ */
+void telem_send_spectrum(uint32_t frame, const int16_t* mags, int nbins);
+
+/* @brief   Sends the TELEM_CNT_* counters
+ *
+ * @param   frames, frames processed so far
+ * @return  none
+ */
+void telem_send_counters(uint32_t frames);
+
+/* @brief   Sends one record of the flash capture log
+ *
+ * @param   frame, frame number stored with the record
+ *          kind, capture_kind_t, chunk index in the high nibble
+ *          payload, record payload
+ *          len, payload bytes
+ * @return  none
+ */
+void telem_send_capture(uint32_t frame, uint8_t kind, const uint8_t* payload, uint16_t len);
+
+/* @brief   Records sent since reset
+ *
+ * @param   none
+ * @return  record count
+ */
+uint32_t telem_record_count();
+
+/* @brief   Per frame hook for main(): pitch and peaks every frame, spectrum
+ *          and counters at their configured intervals
+ *
+ * @param   frame, frame number
+ *          mags, dsp_fft_mag() output for an nsamples point transform
+ *          nsamples, transform length
+ *          bin, dsp_fft_max_pitch() result
+ * @return  none
+ */
+void telem_frame(uint32_t frame, const int16_t* mags, int nsamples, uint16_t bin);
+
+#endif // _TELEMETRY_H_
@@ -14,6 +14,10 @@
 /* @brief   Tests functionality of dsp_fft functions and
  * 			arm_math API
  *
+ * Only runs in test builds (DSP_UNIT_TESTS) and on the host
+ * (make -C tools/host test); normal boots use dsp_selftest() instead.
+ * Define TEST_DSP_VERBOSE to print the first 32 bins.
+ *
  * @param   none
  * @return  number of passing unit tests
  */
@@ -0,0 +1,35 @@
+/*
+ * @file tlog.c
+ *
+ * @brief	Tokenized logging record writer, see tlog.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <fsl_debug_console.h>
+#include <tlog.h>
+
+#define TLOG_HEADER_BYTES (6)
+
+// see .h for more details
+void tlog_write(const char* fmt, const uint32_t* args, uint32_t nargs) {
+
+  uint8_t record[TLOG_HEADER_BYTES + 4*TLOG_MAX_ARGS];
+  uint32_t id = (uint32_t)fmt;
+
+  if (nargs > TLOG_MAX_ARGS) {
+    nargs = TLOG_MAX_ARGS;
+  }
+
+  // the M0+ is little endian, words go out as they sit in memory
+  record[0] = TLOG_SYNC;
+  record[1] = (uint8_t)nargs;
+  memcpy(&record[2], &id, sizeof(id));
+  memcpy(&record[TLOG_HEADER_BYTES], args, 4*nargs);
+
+  DbgConsole_Write(record, TLOG_HEADER_BYTES + 4*nargs);
+}
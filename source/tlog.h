@@ -0,0 +1,70 @@
+/*
+ * @file tlog.h
+ *
+ * @brief	Tokenized (deferred) logging: the device sends a format string ID and
+ * 			the raw argument words, the host does the printf formatting
+ *
+ * Formatting on the M0+ costs a software divide per digit. TLOG() instead
+ * sends one binary record per call and tools/tlog_decode.py expands it with
+ * the format strings read out of the .axf. The ID is the flash address of the
+ * string, so there is no table to keep in sync: rebuild, flash, decode with
+ * the same .axf.
+ *
+ * record (little endian):
+ * 	TLOG_SYNC | nargs | format address (4) | nargs x argument word (4)
+ *
+ * Arguments are 32 bit words: integers, chars and pointers (cast them). %s
+ * only works for strings in flash, the host reads them from the .axf. No %f.
+ * Records share the console with plain printf text, the decoder passes any
+ * byte that does not start a valid record straight through.
+ *
+ * Build options:
+ * 	TLOG_TEXT  TLOG() is a plain printf (also the default on the host)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _TLOG_H_
+#define _TLOG_H_
+
+#include <stdint.h>
+
+#define TLOG_SYNC     (0x1EU)   // ASCII record separator, never in our text output
+#define TLOG_MAX_ARGS (6)
+
+#if defined(TLOG_TEXT) || !defined(__arm__)
+
+#include <stdio.h>
+#define TLOG(fmt, ...) printf(fmt, ##__VA_ARGS__)
+
+#else
+
+/* @brief   Logs fmt and its arguments as one tokenized record
+ *
+ * The format string is a flash constant whose address is the token. Use like
+ * printf: TLOG("bin %d mag %d\n", bin, mag);
+ */
+#define TLOG(fmt, ...)                                                              \
+  do {                                                                              \
+    static const char tlog_fmt_[] __attribute__((section(".rodata.tlog"))) = fmt;   \
+    const uint32_t tlog_args_[] = { 0, ##__VA_ARGS__ };                             \
+    typedef char tlog_too_many_args_[                                               \
+      (sizeof(tlog_args_) / sizeof(uint32_t) <= TLOG_MAX_ARGS + 1) ? 1 : -1]        \
+      __attribute__((unused));                                                      \
+    tlog_write(tlog_fmt_, &tlog_args_[1], sizeof(tlog_args_) / sizeof(uint32_t) - 1); \
+  } while (0)
+
+#endif
+
+/* @brief   Sends one tokenized record to the debug console
+ *
+ * @param   fmt, format string in flash, its address is the token
+ *          args, nargs argument words
+ *          nargs, 0 to TLOG_MAX_ARGS
+ * @return  none
+ */
+void tlog_write(const char* fmt, const uint32_t* args, uint32_t nargs);
+
+#endif // _TLOG_H_
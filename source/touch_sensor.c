@@ -7,20 +7,209 @@
 
 #include <stdio.h>
 #include "MKL25Z4.h"
-#include "common.h"
+#include "touch_sensor.h"
+#include "cpu_cycles.h"
+#include "scheduler.h"
 
 #define INT_TSI0 42
 #define NCHANNELS 16
-#define TSI_THRESHOLD 10
+#define BASELINE_FRAC 4                         // baseline kept in 1/16 counts
+#if (TSI_EVENT_QUEUE_SIZE & (TSI_EVENT_QUEUE_SIZE - 1)) != 0
+#error "TSI_EVENT_QUEUE_SIZE must be a power of two"
+#endif
+
 static volatile uint16_t raw_counts[NCHANNELS];
-static volatile uint16_t base_counts[NCHANNELS];
+static volatile uint32_t base_counts[NCHANNELS]; // IIR baseline << BASELINE_FRAC
 static uint32_t enable_mask;                    // Bitmask of enabled channels
+static int first_channel;                       // lowest enabled channel
+static int nchannels;                           // enabled channel count
+static volatile int scan_hz;                    // 0 = free running software scans
+static volatile bool wakeup_armed;              // out-of-range wakeup mode, see touch_arm_wakeup()
+static volatile bool wakeup_touched;            // an out-of-range scan since touch_arm_wakeup()
+static volatile uint32_t baseline_pending;      // channels whose first scan sets the baseline
+
+// ISR rate and cost, see touch_get_isr_stats()
+static volatile touch_isr_stats_t isr_stats;
+
+// hysteresis detector state, only written by the ISR
+static volatile uint32_t pressed_mask;
+static uint8_t debounce[NCHANNELS];
+static volatile int16_t press_threshold = TSI_THRESHOLD;
+
+// SPSC event queue: the ISR owns head, the main loop owns tail
+static touch_event_t events[TSI_EVENT_QUEUE_SIZE];
+static volatile uint32_t event_head;
+static volatile uint32_t event_tail;
+static volatile uint32_t events_dropped;
 
 // Get current touch input value (normalized to baseline) for specified
 // input channel
 int touch_data(int channel)
 {
-    return raw_counts[channel] - base_counts[channel];
+    return raw_counts[channel] - (int)(base_counts[channel] >> BASELINE_FRAC);
+}
+
+bool touch_is_pressed(int channel)
+{
+    return (pressed_mask & (1U << channel)) != 0;
+}
+
+void touch_set_threshold(int threshold)
+{
+    // release must stay above zero or drift alone could never release
+    if (threshold <= TSI_HYSTERESIS) {
+        threshold = TSI_HYSTERESIS + 1;
+    }
+    press_threshold = (int16_t)threshold;
+}
+
+uint32_t touch_events_dropped(void)
+{
+    return events_dropped;
+}
+
+bool touch_event_get(touch_event_t *event)
+{
+    uint32_t tail = event_tail;
+
+    if (tail == event_head) {
+        return false;
+    }
+    *event = events[tail & (TSI_EVENT_QUEUE_SIZE - 1)];
+    // slot copied out before the ISR may reuse it
+    __DMB();
+    event_tail = tail + 1;
+    return true;
+}
+
+// ISR side of the queue
+static void touch_event_put(uint32_t channel, touch_event_type_t type, int delta)
+{
+    uint32_t head = event_head;
+
+    if (head - event_tail == TSI_EVENT_QUEUE_SIZE) {
+        events_dropped++;
+        return;
+    }
+    touch_event_t *e = &events[head & (TSI_EVENT_QUEUE_SIZE - 1)];
+    e->channel = (uint8_t)channel;
+    e->type = (uint8_t)type;
+    e->delta = (int16_t)delta;
+    // event visible before the new head
+    __DMB();
+    event_head = head + 1;
+    sched_post_isr(SCHED_TASK_TOUCH, SCHED_EV_TOUCH);
+}
+
+// slider estimate, written by the ISR once per sweep
+static volatile touch_slider_t slider;
+static int32_t slider_pos_fixed;                // smoothed position, 1/16 units
+static int32_t slider_vel_fixed;                // smoothed change per sweep, 1/16 units
+
+// b * 1024 / (a + b) by shift and subtract, b <= a + b; no hardware divider on the M0+
+static uint32_t ratio_q10(uint32_t b, uint32_t sum)
+{
+    uint32_t q = 0, r = b;
+    int i;
+    for (i = 0; i < 10; i++) {
+        r <<= 1;
+        q <<= 1;
+        if (r >= sum) {
+            r -= sum;
+            q |= 1;
+        }
+    }
+    // b == sum would give 1024
+    return (q > SLIDER_POSITION_MAX) ? SLIDER_POSITION_MAX : q;
+}
+
+// Position from the two slider electrodes after a full sweep
+static void slider_update(void)
+{
+    int a = touch_data(TSI_SLIDER_CHANNEL_A);
+    int b = touch_data(TSI_SLIDER_CHANNEL_B);
+    if (a < 0) a = 0;
+    if (b < 0) b = 0;
+
+    if (a + b < press_threshold) {
+        slider.touched = false;
+        slider.velocity = 0;
+        slider.held_sweeps = 0;
+        return;
+    }
+
+    int32_t pos = (int32_t)ratio_q10((uint32_t)b, (uint32_t)(a + b)) << BASELINE_FRAC;
+
+    if (!slider.touched) {
+        // finger just landed: start the filters at the first reading
+        slider_pos_fixed = pos;
+        slider_vel_fixed = 0;
+        slider.touched = true;
+    } else {
+        int32_t last = slider_pos_fixed;
+        slider_pos_fixed += (pos - slider_pos_fixed) >> SLIDER_SMOOTH_SHIFT;
+        slider_vel_fixed += ((slider_pos_fixed - last) - slider_vel_fixed) >> SLIDER_SMOOTH_SHIFT;
+    }
+    if (slider.held_sweeps < 0xFFFF) {
+        slider.held_sweeps++;
+    }
+
+    slider.position = (uint16_t)(slider_pos_fixed >> BASELINE_FRAC);
+    int32_t vel = slider_vel_fixed;
+    if (scan_hz > 0) {
+        vel *= scan_hz;
+    }
+    vel >>= BASELINE_FRAC;
+    slider.velocity = (int16_t)((vel > 32767) ? 32767 : (vel < -32768) ? -32768 : vel);
+}
+
+void touch_slider_get(touch_slider_t *out)
+{
+    NVIC_DisableIRQ(TSI0_IRQn);
+    out->touched = slider.touched;
+    out->position = slider.position;
+    out->velocity = slider.velocity;
+    out->held_sweeps = slider.held_sweeps;
+    NVIC_EnableIRQ(TSI0_IRQn);
+}
+
+// Baseline tracking and hysteresis for one finished scan
+static void touch_detect(uint32_t channel, uint16_t raw)
+{
+    uint32_t mask = 1U << channel;
+
+    if (baseline_pending & mask) {
+        base_counts[channel] = (uint32_t)raw << BASELINE_FRAC;
+        baseline_pending &= ~mask;
+        return;
+    }
+
+    int32_t base_fixed = (int32_t)base_counts[channel];
+    int delta = raw - (base_fixed >> BASELINE_FRAC);
+
+    if (pressed_mask & mask) {
+        // baseline frozen while touched so a long press is not learned as drift
+        if (delta < press_threshold - TSI_HYSTERESIS) {
+            pressed_mask &= ~mask;
+            debounce[channel] = 0;
+            touch_event_put(channel, TOUCH_RELEASE, delta);
+        }
+        return;
+    }
+
+    if (delta >= press_threshold) {
+        if (++debounce[channel] >= TSI_DEBOUNCE_SCANS) {
+            pressed_mask |= mask;
+            touch_event_put(channel, TOUCH_PRESS, delta);
+        }
+        return;
+    }
+    debounce[channel] = 0;
+
+    // released: follow slow drift upwards, recover quickly from a dip
+    int32_t error = ((int32_t)raw << BASELINE_FRAC) - base_fixed;
+    base_fixed += (error < 0) ? (error >> 2) : (error >> TSI_BASELINE_SHIFT);
+    base_counts[channel] = (uint32_t)base_fixed;
 }
 
 // Initiate a touch scan on the given channel
@@ -36,6 +225,119 @@ inline static uint16_t scan_data(void)
     return TSI0->DATA & TSI_DATA_TSICNT_MASK;
 }
 
+// Arm the next scan: started now in free running mode, or left waiting for
+// the LPTMR hardware trigger
+inline static void scan_next(int channel)
+{
+    if (scan_hz > 0) {
+        TSI0->DATA = TSI_DATA_TSICH(channel);
+    } else {
+        scan_start(channel);
+    }
+}
+
+void touch_set_scan_rate(int hz)
+{
+    if (hz < 0) {
+        hz = 0;
+    } else if (hz > TSI_SCAN_HZ_MAX) {
+        hz = TSI_SCAN_HZ_MAX;
+    }
+
+    // the trigger mode may only change with the TSI disabled
+    NVIC_DisableIRQ(TSI0_IRQn);
+    TSI0->GENCS &= ~TSI_GENCS_TSIEN_MASK;
+    LPTMR0->CSR = 0;
+    scan_hz = hz;
+
+    if (hz > 0) {
+        // LPTMR counts the 1 kHz LPO, which keeps running in LLS/VLPS;
+        // every compare triggers one scan, so a sweep of all channels
+        // takes nchannels periods
+        uint32_t period_ms = 1000U / (uint32_t)(hz * nchannels);
+        if (period_ms == 0) {
+            period_ms = 1;
+        }
+        SIM->SCGC5 |= SIM_SCGC5_LPTMR_MASK;
+        LPTMR0->PSR = LPTMR_PSR_PCS(1) | LPTMR_PSR_PBYP_MASK;
+        LPTMR0->CMR = period_ms - 1;
+        TSI0->GENCS |= TSI_GENCS_STM_MASK;
+        LPTMR0->CSR = LPTMR_CSR_TEN_MASK;
+    } else {
+        TSI0->GENCS &= ~TSI_GENCS_STM_MASK;
+    }
+
+    isr_stats.count = 0;
+    isr_stats.cycles_total = 0;
+    isr_stats.cycles_max = 0;
+
+    TSI0->GENCS |= TSI_GENCS_TSIEN_MASK;
+    NVIC_EnableIRQ(TSI0_IRQn);
+    scan_next(first_channel);
+}
+
+void touch_arm_wakeup(int channel)
+{
+    uint32_t base = base_counts[channel] >> BASELINE_FRAC;
+    uint32_t thresh = base + press_threshold;
+
+    NVIC_DisableIRQ(TSI0_IRQn);
+    TSI0->GENCS &= ~TSI_GENCS_TSIEN_MASK;
+    LPTMR0->CSR = 0;
+
+    // interrupt only when the count leaves [0, baseline + threshold]
+    TSI0->TSHD = TSI_TSHD_THRESH(thresh > 0xFFFF ? 0xFFFF : thresh) | TSI_TSHD_THRESL(0);
+    TSI0->GENCS = (TSI0->GENCS & ~(TSI_GENCS_ESOR_MASK | TSI_GENCS_EOSF_MASK))
+                | TSI_GENCS_OUTRGF_MASK | TSI_GENCS_STM_MASK;
+
+    // one channel at the sweep rate, paced by the LPTMR which keeps running in LLS/VLPS.
+    // The TSI no longer interrupts every scan, so the LPTMR's own interrupt clears the
+    // compare flag that triggers the next scan
+    uint32_t period_ms = (scan_hz > 0) ? 1000U / (uint32_t)scan_hz : 1000U / TSI_SCAN_HZ;
+    SIM->SCGC5 |= SIM_SCGC5_LPTMR_MASK;
+    LPTMR0->PSR = LPTMR_PSR_PCS(1) | LPTMR_PSR_PBYP_MASK;
+    LPTMR0->CMR = (period_ms > 0) ? period_ms - 1 : 0;
+    LPTMR0->CSR = LPTMR_CSR_TEN_MASK | LPTMR_CSR_TIE_MASK;
+    NVIC_ClearPendingIRQ(LPTMR0_IRQn);
+    NVIC_EnableIRQ(LPTMR0_IRQn);
+
+    wakeup_touched = false;
+    wakeup_armed = true;
+    TSI0->GENCS |= TSI_GENCS_TSIEN_MASK;
+    TSI0->DATA = TSI_DATA_TSICH(channel);
+    NVIC_ClearPendingIRQ(TSI0_IRQn);
+    NVIC_EnableIRQ(TSI0_IRQn);
+}
+
+void touch_disarm_wakeup(void)
+{
+    NVIC_DisableIRQ(TSI0_IRQn);
+    NVIC_DisableIRQ(LPTMR0_IRQn);
+    TSI0->GENCS &= ~TSI_GENCS_TSIEN_MASK;
+    TSI0->GENCS |= TSI_GENCS_ESOR_MASK | TSI_GENCS_OUTRGF_MASK;
+    wakeup_armed = false;
+    // restores the sweep and re-enables the interrupt
+    touch_set_scan_rate(scan_hz);
+}
+
+bool touch_wakeup_touched(void)
+{
+    return wakeup_touched;
+}
+
+// Armed for wakeup only: the compare flag is the scan trigger, clear it every period
+void LPTMR0_IRQHandler(void)
+{
+    LPTMR0->CSR |= LPTMR_CSR_TCF_MASK;
+}
+
+void touch_get_isr_stats(touch_isr_stats_t *stats)
+{
+    NVIC_DisableIRQ(TSI0_IRQn);
+    *stats = isr_stats;
+    NVIC_EnableIRQ(TSI0_IRQn);
+}
+
 // Initialize touch input
 void touch_sensor_init(uint32_t channel_mask)
 {
@@ -60,38 +362,78 @@ void touch_sensor_init(uint32_t channel_mask)
     PORTB->PCR[17] = PORT_PCR_MUX(0);      // PTB17 as touch channel 10
 
     // Read initial (baseline) values for each enabled channel
-    int i, first_channel = 0;
+    int i;
     enable_mask = channel_mask;
+    nchannels = 0;
     for(i=15; i>=0; i--) {
         if((1 << i) & enable_mask) {
+#if !defined(BOOT_FAST_START)
             scan_start(i);
             while(!(TSI0->GENCS & TSI_GENCS_EOSF_MASK))      // Wait until done
                 ;
 
-            base_counts[i] = scan_data();
+            base_counts[i] = (uint32_t)scan_data() << BASELINE_FRAC;
+#endif
             first_channel = i;
+            nchannels++;
         }
     }
+#if defined(BOOT_FAST_START)
+    // no waiting here (~1 ms per electrode): the first interrupt driven
+    // sweep sets the baselines, see touch_detect()
+    baseline_pending = enable_mask;
+#endif
 
-    // Enable TSI interrupts and start the first scan
+    // Enable TSI interrupts and start scanning at the configured rate
     enable_irq(INT_TSI0);
-    scan_start(first_channel);
+    touch_set_scan_rate(TSI_SCAN_HZ);
 }
 
 // Touch input interrupt handler
 void TSI0_IRQHandler() __attribute__((interrupt("IRQ")));
 void TSI0_IRQHandler(void)
 {
+    uint32_t start = cpu_cycles_now();
+
     // Save data for channel
     uint32_t channel = (TSI0->DATA & TSI_DATA_TSICH_MASK) >> TSI_DATA_TSICH_SHIFT;
     raw_counts[channel] = scan_data();
+    touch_detect(channel, raw_counts[channel]);
+
+    // the sweep runs upwards, so channel B finishing completes a slider pair
+    if (channel == TSI_SLIDER_CHANNEL_B && (enable_mask & (1U << TSI_SLIDER_CHANNEL_A)) &&
+        !baseline_pending) {
+        slider_update();
+    }
 
-    // Start a new scan on next enabled channel
+    // the trigger is the LPTMR compare flag, clear it for the next period
+    if (scan_hz > 0 || wakeup_armed) {
+        LPTMR0->CSR |= LPTMR_CSR_TCF_MASK;
+    }
+
+    // armed for wakeup: the out-of-range scan that woke us has been recorded,
+    // keep rescanning the same channel until touch_disarm_wakeup()
+    if (wakeup_armed) {
+        wakeup_touched = true;
+        TSI0->GENCS |= TSI_GENCS_OUTRGF_MASK;
+        TSI0->DATA = TSI_DATA_TSICH(channel);
+        isr_stats.count++;
+        return;
+    }
+
+    // Arm a new scan on next enabled channel
     for(;;) {
         channel = (channel + 1) % NCHANNELS;
         if ((1 << channel) & enable_mask) {
-            scan_start(channel);
-            return;
+            scan_next(channel);
+            break;
         }
     }
+
+    uint32_t cycles = cpu_cycles_since(start);
+    isr_stats.count++;
+    isr_stats.cycles_total += cycles;
+    if (cycles > isr_stats.cycles_max) {
+        isr_stats.cycles_max = cycles;
+    }
 }
@@ -12,15 +12,97 @@
 #ifndef __TOUCH_SENSOR_H_
 #define __TOUCH_SENSOR_H_
 
+#include <stdbool.h>
 #include "MKL25Z4.h"
 #define TSI_SENSOR_CHANNEL (10)
 
+// Touch detection runs in TSI0_IRQHandler after every scan:
+//  - each channel keeps an IIR baseline (1/2^TSI_BASELINE_SHIFT per scan) that only
+//    moves while the channel is released, and falls faster when the count drops below it
+//  - press when the count sits TSI_THRESHOLD above the baseline for TSI_DEBOUNCE_SCANS
+//    scans in a row, release when it falls below TSI_THRESHOLD - TSI_HYSTERESIS
+//  - press/release events go into a single producer/single consumer queue that the
+//    main loop drains with touch_event_get(), so a touch is never missed between frames
+//  - scans are paced by LPTMR0 hardware triggers at TSI_SCAN_HZ sweeps per second rather
+//    than restarted from the ISR, so the CPU takes nchannels x TSI_SCAN_HZ interrupts per
+//    second instead of one every electrode scan (~1 ms with NSCN 11, PS 4)
+//  - touch_sensor_init() scans every enabled channel once for its starting baseline;
+//    with BOOT_FAST_START (boot_profile.h) it returns at once and the first sweep does it
+//  - with channels 9 and 10 enabled the ISR also turns the pair into a slider position by
+//    the ratio of their deltas, in integer math, see touch_slider_get()
+
+typedef enum {
+    TOUCH_RELEASE = 0,
+    TOUCH_PRESS   = 1
+} touch_event_type_t;
+
+typedef struct {
+    uint8_t channel;
+    uint8_t type;       // touch_event_type_t
+    int16_t delta;      // counts above baseline when the event fired
+} touch_event_t;
+
+// TSI0_IRQHandler calls and cost, cycles exclude the ~15 cycle exception entry/exit
+typedef struct {
+    uint32_t count;
+    uint32_t cycles_total;
+    uint32_t cycles_max;
+} touch_isr_stats_t;
+
+// FRDM-KL25Z slider: two interleaved electrodes, channel 9 (PTB16) and 10 (PTB17)
+#define TSI_SLIDER_CHANNEL_A 9
+#define TSI_SLIDER_CHANNEL_B 10
+#define SLIDER_POSITION_MAX 1023  // position is 0 (channel 9 end) .. 1023 (channel 10 end)
+#define SLIDER_SMOOTH_SHIFT 2     // position/velocity IIR 1/4 per sweep
+
+typedef struct {
+    bool touched;
+    uint16_t position;      // 0..SLIDER_POSITION_MAX, smoothed
+    int16_t velocity;       // position units per second (per sweep when scans free run)
+    uint16_t held_sweeps;   // sweeps since the finger landed, saturates
+} touch_slider_t;
+
 // Touch Sensor function prototypes
 void touch_sensor_init(uint32_t channel_mask);
 
 int touch_data(int channel);
 void touch_init(uint32_t channel_mask);
 
+// Takes the oldest press/release event, false when the queue is empty
+bool touch_event_get(touch_event_t *event);
+
+// Whether the detector currently considers the channel pressed
+bool touch_is_pressed(int channel);
+
+// Changes the press threshold (counts above baseline), release stays TSI_HYSTERESIS below it
+void touch_set_threshold(int threshold);
+
+// Sweeps of all enabled channels per second, 1..TSI_SCAN_HZ_MAX scans from the LPTMR
+// hardware trigger (TSI_GENCS_STM), 0 scans back to back from the ISR as before.
+// Also clears the ISR statistics.
+void touch_set_scan_rate(int hz);
+
+// Latest slider estimate, updated in the ISR after each sweep when both slider channels are enabled
+void touch_slider_get(touch_slider_t *slider);
+
+// Standby: scans only the given channel at the sweep rate and interrupts only when its count
+// rises TSI_THRESHOLD above the baseline (out-of-range mode). The TSI and LPTMR keep running in
+// LLS/VLPS, and the interrupt (through LLWU source 4 in LLS) wakes the core. The LPTMR also
+// interrupts every period (LLWU source 0) to clear the compare flag that triggers the scans.
+void touch_arm_wakeup(int channel);
+
+// Whether an out-of-range scan (a touch) happened since touch_arm_wakeup()
+bool touch_wakeup_touched(void);
+
+// Leaves the out-of-range mode and restarts the normal sweep
+void touch_disarm_wakeup(void);
+
+// ISR count and cycle cost since the last touch_set_scan_rate()
+void touch_get_isr_stats(touch_isr_stats_t *stats);
+
+// Events lost because the main loop did not drain the queue in time
+uint32_t touch_events_dropped(void);
+
 // Interrupt enabling and disabling
 static inline void enable_irq(int n) {
     NVIC->ICPR[0] |= 1 << (n - 16);
@@ -30,6 +112,14 @@ static inline void enable_irq(int n) {
 // Macros
 #define SCAN_OFFSET 586 // Offset for scan range
 #define SCAN_DATA TSI0->DATA & 0xFFFF // Accessing the bits held in TSI0_DATA_TSICNT
-#define TSI_THRESHOLD 15
+#define TSI_THRESHOLD 15          // press: counts above baseline
+#define TSI_HYSTERESIS 5          // release below TSI_THRESHOLD - TSI_HYSTERESIS
+#define TSI_DEBOUNCE_SCANS 2      // consecutive scans above threshold for a press
+#define TSI_BASELINE_SHIFT 6      // baseline IIR coefficient 1/64 per scan
+#define TSI_EVENT_QUEUE_SIZE 8    // power of two
+#ifndef TSI_SCAN_HZ
+#define TSI_SCAN_HZ 40            // channel sweeps per second, 0 = continuous
+#endif
+#define TSI_SCAN_HZ_MAX 200
 
 #endif
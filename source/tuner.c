@@ -0,0 +1,162 @@
+/*
+ * @file tuner.c
+ *
+ * @brief	Chromatic tuner, see tuner.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <tuner.h>
+
+// log2(1 + i/64) in q15, i = 0 .. 64
+static const uint16_t log2_table[65] = {
+  0, 733, 1455, 2166, 2866, 3556, 4236, 4907, 5568, 6220, 6863, 7498, 8124,
+  8742, 9352, 9954, 10549, 11136, 11716, 12289, 12855, 13415, 13968, 14514, 15055,
+  15589, 16117, 16639, 17156, 17667, 18173, 18673, 19168, 19658, 20143, 20623, 21098,
+  21568, 22034, 22495, 22952, 23404, 23852, 24296, 24736, 25172, 25604, 26031, 26455,
+  26876, 27292, 27705, 28114, 28520, 28922, 29321, 29717, 30109, 30498, 30884, 31267,
+  31647, 32024, 32397, 32768
+};
+
+// 2^20 / d, d = 64 .. 127
+static const uint16_t recip_table[64] = {
+  16384, 16132, 15888, 15650, 15420, 15197, 14980, 14769, 14564, 14364, 14170, 13981,
+  13797, 13618, 13443, 13273, 13107, 12945, 12788, 12633, 12483, 12336, 12193, 12053,
+  11916, 11782, 11651, 11523, 11398, 11275, 11155, 11038, 10923, 10810, 10700, 10592,
+  10486, 10382, 10280, 10180, 10082, 9986, 9892, 9800, 9709, 9620, 9533, 9447,
+  9362, 9279, 9198, 9118, 9039, 8962, 8886, 8812, 8738, 8666, 8595, 8525,
+  8456, 8389, 8322, 8257
+};
+
+static const char note_names[12][3] = {
+  "C ", "C#", "D ", "D#", "E ", "F ", "F#", "G ", "G#", "A ", "A#", "B "
+};
+
+// see .h for more details
+int32_t tuner_log2_q15(uint32_t x) {
+  if (x == 0) {
+    return 0;
+  }
+
+  // integer part by binary search, the M0+ has no CLZ
+  uint32_t v = x;
+  int32_t e = 0;
+  if (v >= (1U << 16)) { v >>= 16; e += 16; }
+  if (v >= (1U << 8))  { v >>= 8;  e += 8; }
+  if (v >= (1U << 4))  { v >>= 4;  e += 4; }
+  if (v >= (1U << 2))  { v >>= 2;  e += 2; }
+  if (v >= (1U << 1))  { e += 1; }
+
+  // leading one to bit 31: 6 bits of table index, the next 16 interpolate
+  uint32_t m = x << (31 - e);
+  uint32_t i = (m >> 25) & 63U;
+  int32_t frac = (int32_t)((m >> 9) & 0xFFFFU);
+  int32_t lo = log2_table[i];
+  return (e << 15) + lo + (((log2_table[i + 1] - lo) * frac) >> 16);
+}
+
+// a local maximum of the spectrum
+static bool tuner_is_peak(const int16_t* mag, uint32_t k) {
+  return mag[k] >= mag[k - 1] && mag[k] >= mag[k + 1];
+}
+
+// log2 power of a bin, empty bins count as 1
+static int32_t tuner_log_power(int16_t p) {
+  return tuner_log2_q15((p > 1) ? (uint32_t)p : 1U);
+}
+
+// offset of the true peak from bin k in 1/256 bin, -128 .. 128
+static int32_t tuner_interpolate(const int16_t* mag, uint32_t k) {
+  int32_t la = tuner_log_power(mag[k - 1]);
+  int32_t lb = tuner_log_power(mag[k]);
+  int32_t lc = tuner_log_power(mag[k + 1]);
+
+  // vertex of the parabola: (lc - la) / (2 * (2lb - la - lc)), |n| <= d at a peak
+  int32_t n = lc - la;
+  int32_t d = 2 * lb - la - lc;
+  if (d <= 0) {
+    return 0;
+  }
+  // both scaled until d indexes the reciprocal table
+  while (d >= 128) {
+    d >>= 1;
+    n >>= 1;
+  }
+  while (d < 64) {
+    d <<= 1;
+    n <<= 1;
+  }
+  int32_t delta = (n * recip_table[d - 64]) >> 13;
+  if (delta > 128) delta = 128;
+  if (delta < -128) delta = -128;
+  return delta;
+}
+
+// see .h for more details
+bool tuner_estimate(const int16_t* fft_mag, int16_t min_power, tuner_note_t* out) {
+  uint32_t k = TUNER_MIN_BIN;
+  for (uint32_t i = TUNER_MIN_BIN + 1; i <= TUNER_MAX_BIN; i++) {
+    if (fft_mag[i] > fft_mag[k]) {
+      k = i;
+    }
+  }
+  if (fft_mag[k] < min_power || fft_mag[k] <= 0) {
+    return false;
+  }
+
+  // a peak near half the bin with enough power is the fundamental, the
+  // strongest bin was one of its harmonics
+  for (;;) {
+    uint32_t h = k >> 1;
+    if (h < TUNER_MIN_BIN) {
+      break;
+    }
+    uint32_t j = h - 1;
+    for (uint32_t i = h; i <= h + 1; i++) {
+      if (fft_mag[i] > fft_mag[j]) {
+        j = i;
+      }
+    }
+    if (j < TUNER_MIN_BIN || fft_mag[j] < min_power ||
+        fft_mag[j] < (fft_mag[k] >> TUNER_SUBHARMONIC_SHIFT) || !tuner_is_peak(fft_mag, j)) {
+      break;
+    }
+    k = j;
+  }
+
+  // Hz * 16 == 1/256 bin while a bin is 16 Hz
+  int32_t pos = (int32_t)(k << 8) + tuner_interpolate(fft_mag, k);
+  int32_t freq_q4 = pos << (TUNER_BIN_LOG2 - 4);
+  if (freq_q4 < TUNER_MIN_FREQ_Q4 || freq_q4 > TUNER_MAX_FREQ_Q4) {
+    return false;
+  }
+
+  // semitones from A4 in q15, log2(Hz * 16) - log2(A4 * 16) is the octave count
+  int32_t semis = 12 * (tuner_log2_q15((uint32_t)freq_q4) - tuner_log2_q15(TUNER_A4_HZ << 4));
+  int32_t semi = (semis + (1 << 14)) >> 15;
+  int32_t cents = ((semis - semi * 32768) * 100 + (1 << 14)) >> 15;
+  if (cents >= 50) {
+    semi++;
+    cents -= 100;
+  }
+
+  // octave = midi / 12 - 1, 43691 / 2^19 is 1/12 to within 1e-5
+  int32_t midi = 69 + semi;
+  int32_t octave = (midi * 43691) >> 19;
+  out->freq_q4 = (uint16_t)freq_q4;
+  out->note = (uint8_t)(midi - 12 * octave);
+  out->octave = (int8_t)(octave - 1);
+  out->cents = (int8_t)cents;
+  out->midi = (uint8_t)midi;
+  out->bin = (uint16_t)k;
+  return true;
+}
+
+// see .h for more details
+const char* tuner_note_name(uint8_t note) {
+  return note_names[(note < 12) ? note : 0];
+}
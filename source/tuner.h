@@ -0,0 +1,95 @@
+/*
+ * @file tuner.h
+ *
+ * @brief	Chromatic tuner: the fundamental of a power spectrum as an equal
+ * 			tempered note, octave and signed cents offset
+ *
+ * Any fundamental from 60 Hz to 4 kHz works, not just the seven notes
+ * dsp_fft_pitch_detect() knows. There are no divides and no floats, so it can
+ * run every frame:
+ *
+ * 	1. peak: the strongest bin from TUNER_MIN_BIN to TUNER_MAX_BIN. While a
+ * 	   local maximum near half its bin holds at least 1/2^TUNER_SUBHARMONIC_SHIFT
+ * 	   of its power, that subharmonic is taken instead, so a strong 2nd harmonic
+ * 	   is not read an octave high.
+ * 	2. interpolation: a parabola through the log2 power of the peak and its
+ * 	   two neighbours (Gaussian interpolation, within a few hundredths of a bin
+ * 	   for the Hann window). The 1/x it needs comes from a 64 entry
+ * 	   reciprocal table, after the denominator is shifted into 64..127.
+ * 	3. note: log2 of the interpolated frequency from a 65 entry table of
+ * 	   log2(1 + i/64), linearly interpolated (error under 0.1 cent). Twelve
+ * 	   times its distance from log2(TUNER_A4_HZ) gives semitones in q15. The
+ * 	   nearest semitone is the note and the remainder gives the cents.
+ *
+ * A 512 point frame at 8192 Hz has 16 Hz bins, about 450 cents at 60 Hz and
+ * 7 cents at 4 kHz. The interpolated peak still names the low notes right, but
+ * their cents are only good to about 10 (octaves 1 and 2); from octave 4 up the
+ * error is 1-2 cents (tools/host test_tuner).
+ *
+ * Build options:
+ * 	TUNER_A4_HZ               reference pitch of A4 (default 440)
+ * 	TUNER_SUBHARMONIC_SHIFT   subharmonic power needed, as a right shift of the peak (default 3)
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _TUNER_H_
+#define _TUNER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef TUNER_A4_HZ
+#define TUNER_A4_HZ (440)
+#endif
+
+#ifndef TUNER_SUBHARMONIC_SHIFT
+#define TUNER_SUBHARMONIC_SHIFT (3)
+#endif
+
+// 8192 Hz / 512 bins = 16 Hz = 2^4 per bin
+#define TUNER_BIN_LOG2 (4)
+
+// peak search range, 64 Hz .. 4000 Hz (the neighbours reach 48 and 4016 Hz)
+#define TUNER_MIN_BIN  (4)
+#define TUNER_MAX_BIN  (250)
+
+// interpolated frequency range in Hz * 16, 60 Hz .. 4 kHz
+#define TUNER_MIN_FREQ_Q4 (60 << 4)
+#define TUNER_MAX_FREQ_Q4 (4000 << 4)
+
+typedef struct {
+  uint16_t freq_q4;         // interpolated fundamental, Hz * 16
+  uint8_t note;             // 0 C, 1 C#, ... 11 B
+  int8_t octave;            // scientific pitch notation, A4 is 440 Hz
+  int8_t cents;             // -50 .. 49, sharp is positive
+  uint8_t midi;             // MIDI note number, 69 is A4
+  uint16_t bin;             // peak bin after the subharmonic check
+} tuner_note_t;
+
+/* @brief   log2 of an integer from a table, no divides
+ *
+ * @param   x, 1 .. 2^32 - 1 (0 gives 0)
+ * @return  log2(x) in q15, e.g. 3 << 15 for 8
+ */
+int32_t tuner_log2_q15(uint32_t x);
+
+/* @brief   Finds the fundamental and its note
+ *
+ * @param   fft_mag, power spectrum from dsp_fft_mag(), at least TUNER_MAX_BIN + 2 bins
+ *          min_power, a peak below this is no note
+ *          out, the note, written only when true is returned
+ * @return  false if there is no peak of min_power or it lies outside 60 Hz .. 4 kHz
+ */
+bool tuner_estimate(const int16_t* fft_mag, int16_t min_power, tuner_note_t* out);
+
+/* @brief   Name of a note for the console, two characters
+ *
+ * @param   note, tuner_note_t.note
+ * @return  letter and '#' or ' ', e.g. "C#"
+ */
+const char* tuner_note_name(uint8_t note);
+
+#endif // _TUNER_H_
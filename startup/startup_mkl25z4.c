@@ -83,6 +83,12 @@ __attribute__ ((used,section(".FlashConfig"))) const struct {
 extern void SystemInit(void);
 #endif // (__USE_CMSIS)
 
+//*****************************************************************************
+// Boot phase stamps and the fast start clock bring-up, see boot_profile.h.
+// Both run before .data/.bss are initialized and only touch registers.
+//*****************************************************************************
+#include "boot_profile.h"
+
 //*****************************************************************************
 // Forward declaration of the core exception handlers.
 // When the application defines a handler (with the same name), this will
@@ -278,6 +284,27 @@ void bss_init(unsigned int start, unsigned int len) {
 		*pulDest++ = 0;
 }
 
+//*****************************************************************************
+// Fill the free RAM between the end of the heap and the current stack pointer
+// with STACK_PAINT_PATTERN so that mem_usage.c can later find how deep the
+// stack has grown. The stack pointer is read inside this function, so its own
+// frame sits above the painted range. Define __STACK_PAINT_DISABLE to skip.
+//*****************************************************************************
+#if !defined (__STACK_PAINT_DISABLE)
+#include "mem_usage.h"
+
+extern unsigned int _pvHeapLimit;
+
+__attribute__ ((section(".after_vectors.init_stack")))
+void stack_paint(void) {
+	unsigned int *pulDest = &_pvHeapLimit;
+	unsigned int *pulEnd;
+	__asm volatile ("mov %0, sp" : "=r" (pulEnd));
+	while (pulDest < pulEnd)
+		*pulDest++ = STACK_PAINT_PATTERN;
+}
+#endif // !defined (__STACK_PAINT_DISABLE)
+
 //*****************************************************************************
 // The following symbols are constructs generated by the linker, indicating
 // the location of various points in the "Global Section Table". This table is
@@ -310,6 +337,16 @@ void ResetISR(void) {
     *((volatile unsigned int *)0x40048100) = 0x00u;
 #endif // (__USE_CMSIS)
 
+#if !defined (BOOT_PROFILE_DISABLE)
+    // SysTick from zero, main() measures the boot phases from here
+    boot_profile_start();
+#endif // !defined (BOOT_PROFILE_DISABLE)
+
+#if defined (BOOT_FAST_START)
+    // crystal and PLL lock while the sections are copied
+    boot_clock_start();
+#endif // defined (BOOT_FAST_START)
+
     //
     // Copy the data sections from flash to SRAM.
     //
@@ -335,6 +372,11 @@ void ResetISR(void) {
 		bss_init(ExeAddr, SectionLen);
 	}
 
+#if !defined (__STACK_PAINT_DISABLE)
+	// Paint unused RAM for the stack high-water-mark
+	stack_paint();
+#endif // !defined (__STACK_PAINT_DISABLE)
+
 #if !defined (__USE_CMSIS)
 // Assume that if __USE_CMSIS defined, then CMSIS SystemInit code
 // will setup the VTOR register
@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""
+bench_compare.py - compare two bench_dsp_fft JSON runs
+
+Matches results by (engine, n) and reports the ns/frame change. Exits 1 when
+any case got slower than --threshold percent, so it can gate a CI job.
+
+usage: bench_compare.py baseline.json current.json [--threshold 10]
+
+@author  Ishmael Pelayo
+@date    2026-10-18
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        doc = json.load(f)
+    return {(r["engine"], r["n"]): r for r in doc["results"]}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("baseline")
+    ap.add_argument("current")
+    ap.add_argument("--threshold", type=float, default=10.0,
+                    help="allowed slowdown in percent (default 10)")
+    args = ap.parse_args()
+
+    base = load(args.baseline)
+    cur = load(args.current)
+
+    regressions = 0
+    print("%-15s %5s %12s %12s %8s %s" % ("engine", "n", "base ns", "cur ns", "delta", ""))
+    for key in sorted(cur, key=lambda k: (k[0], k[1])):
+        if key not in base:
+            continue
+        b = base[key]["ns_per_frame"]
+        c = cur[key]["ns_per_frame"]
+        delta = 100.0 * (c - b) / b
+        flag = ""
+        if delta > args.threshold:
+            flag = "REGRESSION"
+            regressions += 1
+        if cur[key]["allocs_per_frame"] > base[key]["allocs_per_frame"]:
+            flag += " ALLOCS"
+            regressions += 1
+        print("%-15s %5d %12.1f %12.1f %+7.1f%% %s" % (key[0], key[1], b, c, delta, flag))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
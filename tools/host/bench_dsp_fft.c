@@ -0,0 +1,176 @@
+/*
+ * @file bench_dsp_fft.c
+ *
+ * @brief	Host throughput benchmark for the dsp_fft.c pipeline
+ *
+ * Sweeps N = 64..4096 over each engine and prints one JSON document on stdout
+ * so runs can be archived and diffed with tools/bench_compare.py.
+ *
+ * engines:
+ * 	q15_mag        dsp_fft_mag()                        (CMSIS q15 rfft)
+ * 	q15_mag_pitch  dsp_fft_mag() + dsp_fft_max_pitch()  (what main.c runs per frame)
+ * 	f64_reference  ref_fft_mag()                        (double precision ground truth)
+ *
+ * usage: bench_dsp_fft [--min-ms <ms per case>] [--n <single size>]
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dsp_fft.h>
+#include "host_alloc.h"
+#include "host_ref_fft.h"
+
+#define SAMPLING_RATE (8192)
+#define TONE_HZ       (1000)
+#define MIN_N         (64)
+#define MAX_N         (4096)
+#define DEFAULT_MIN_MS (200)
+
+#ifndef M_PI
+#define M_PI (3.14159265358979323846)
+#endif
+
+// one engine under test, run() processes exactly one frame
+typedef struct {
+  const char* name;
+  const char* precision;
+  int (*run)(uint16_t* samples, int n);
+  // model of buffer bytes read + written per frame, twiddle tables excluded
+  long (*bytes_touched)(int n);
+} bench_engine_t;
+
+static double ref_work[2*MAX_N];
+static double ref_mag[MAX_N];
+static volatile int sink;
+
+static int run_q15_mag(uint16_t* samples, int n) {
+  int16_t* mags = dsp_fft_mag(samples, n);
+  if (mags == NULL) return -1;
+  sink = mags[1];
+  return 0;
+}
+
+static int run_q15_mag_pitch(uint16_t* samples, int n) {
+  int16_t* mags = dsp_fft_mag(samples, n);
+  if (mags == NULL) return -1;
+  sink = dsp_fft_max_pitch(mags);
+  return 0;
+}
+
+static int run_f64_reference(uint16_t* samples, int n) {
+  if (ref_fft_mag(samples, n, ref_work, ref_mag) != 0) return -1;
+  sink = (int)ref_mag[1];
+  return 0;
+}
+
+// samples + window read, q15 input, rfft output (2n), magnitudes written
+static long bytes_q15_mag(int n) {
+  return 2L*n + 2L*n + 2L*n + 4L*n + 2L*n;
+}
+
+// as above plus the first 32 bins scanned by dsp_fft_max_pitch
+static long bytes_q15_mag_pitch(int n) {
+  return bytes_q15_mag(n) + 32L*2;
+}
+
+// samples read, complex work array (2n doubles), magnitudes written
+static long bytes_f64_reference(int n) {
+  return 2L*n + 16L*n + 8L*n;
+}
+
+static const bench_engine_t engines[] = {
+  { "q15_mag",       "q15", run_q15_mag,       bytes_q15_mag       },
+  { "q15_mag_pitch", "q15", run_q15_mag_pitch, bytes_q15_mag_pitch },
+  { "f64_reference", "f64", run_f64_reference, bytes_f64_reference },
+};
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// a 1 kHz tone riding on the mic bias with a little deterministic noise,
+// roughly what the ADC delivers in test_dsp_fft.c
+static void make_tone(uint16_t* samples, int n) {
+  uint32_t lcg = 12345;
+  for (int i = 0; i < n; i++) {
+    lcg = lcg * 1664525u + 1013904223u;
+    double noise = (double)((lcg >> 16) & 0x3FF) - 512.0;
+    double v = (1 << 15) + 12000.0 * cos(2.0 * M_PI * TONE_HZ * i / SAMPLING_RATE) + noise;
+    samples[i] = (uint16_t)v;
+  }
+}
+
+int main(int argc, char** argv) {
+
+  double min_ms = DEFAULT_MIN_MS;
+  int only_n = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--min-ms") && i + 1 < argc) {
+      min_ms = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--n") && i + 1 < argc) {
+      only_n = atoi(argv[++i]);
+    } else {
+      fprintf(stderr, "usage: %s [--min-ms <ms>] [--n <size>]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  static uint16_t samples[MAX_N];
+  int first = 1;
+
+  printf("{\n  \"benchmark\": \"dsp_fft\",\n  \"fs_hz\": %d,\n  \"min_ms\": %.0f,\n  \"results\": [\n",
+         SAMPLING_RATE, min_ms);
+
+  for (int n = MIN_N; n <= MAX_N; n <<= 1) {
+    if (only_n && n != only_n) continue;
+    make_tone(samples, n);
+
+    for (size_t e = 0; e < sizeof(engines)/sizeof(engines[0]); e++) {
+      const bench_engine_t* eng = &engines[e];
+
+      // warm up caches and reject sizes the engine does not support
+      if (eng->run(samples, n) != 0) {
+        fprintf(stderr, "%s: N=%d not supported\n", eng->name, n);
+        continue;
+      }
+
+      // double the batch until one batch alone takes at least min_ms
+      long iters = 1;
+      double elapsed;
+      uint64_t allocs;
+      for (;;) {
+        uint64_t a0 = host_alloc_count();
+        double t0 = now_ns();
+        for (long k = 0; k < iters; k++) {
+          eng->run(samples, n);
+        }
+        elapsed = now_ns() - t0;
+        allocs = host_alloc_count() - a0;
+        if (elapsed >= min_ms * 1e6 || iters >= (1L << 30)) break;
+        iters <<= 1;
+      }
+
+      double ns_frame = elapsed / iters;
+      printf("%s    {\"engine\": \"%s\", \"precision\": \"%s\", \"n\": %d, "
+             "\"iterations\": %ld, \"ns_per_frame\": %.1f, \"frames_per_sec\": %.1f, "
+             "\"bytes_touched\": %ld, \"allocs_per_frame\": %.3f}",
+             first ? "" : ",\n", eng->name, eng->precision, n, iters, ns_frame,
+             1e9 / ns_frame, eng->bytes_touched(n), (double)allocs / iters);
+      first = 0;
+    }
+  }
+
+  printf("\n  ]\n}\n");
+  return 0;
+}
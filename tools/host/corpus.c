@@ -0,0 +1,190 @@
+/*
+ * @file corpus.c
+ *
+ * @brief	Golden-vector generator, see corpus.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <dsp_fft.h>
+#include "corpus.h"
+
+#ifndef M_PI
+#define M_PI (3.14159265358979323846)
+#endif
+
+#define BIN_HZ       ((double)CORPUS_SAMPLING_RATE / CORPUS_NSAMPLES)
+#define FULL_SCALE   (32767.0)
+
+static const int formants[] = {
+  FORMANT_G4, FORMANT_G5, FORMANT_B5, FORMANT_D_SHARP6,
+  FORMANT_E_FLAT7, FORMANT_G7, FORMANT_B7
+};
+#define NFORMANTS ((int)(sizeof(formants)/sizeof(formants[0])))
+
+static const double tone_levels_db[]  = { -30.0, -20.0, -12.0, -6.0, -3.0 };
+static const double harmonic_rolloff[] = { 0.25, 0.5, 0.8, 1.2 };  // 2f gain = rolloff, 3f = rolloff^2 ...
+static const double drift_slopes[]     = { -4000.0, -1000.0, 1000.0, 4000.0 };  // counts per frame
+#define NLEVELS   ((int)(sizeof(tone_levels_db)/sizeof(tone_levels_db[0])))
+#define NROLLOFF  ((int)(sizeof(harmonic_rolloff)/sizeof(harmonic_rolloff[0])))
+#define NSLOPES   ((int)(sizeof(drift_slopes)/sizeof(drift_slopes[0])))
+#define NNOISE    (36)  // noise vectors per variant, per colour
+
+// vectors per variant of each kind, in kind order
+static int kind_count(corpus_kind_t kind) {
+  switch (kind) {
+    case CORPUS_TONE:        return NFORMANTS * NLEVELS;
+    case CORPUS_HARMONIC:    return NFORMANTS * NROLLOFF;
+    case CORPUS_WHITE_NOISE: return NNOISE;
+    case CORPUS_PINK_NOISE:  return NNOISE;
+    case CORPUS_CHIRP:       return NFORMANTS * NLEVELS;
+    case CORPUS_DC_DRIFT:    return NFORMANTS * NSLOPES;
+    default:                 return 0;
+  }
+}
+
+// xorshift32, one stream per vector
+static uint32_t rng_next(uint32_t* state) {
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *state = x;
+}
+
+// uniform in [-1, 1)
+static double rng_uniform(uint32_t* state) {
+  return (double)rng_next(state) / 2147483648.0 - 1.0;
+}
+
+const char* corpus_kind_name(corpus_kind_t kind) {
+  static const char* names[CORPUS_NUM_KINDS] = {
+    "tone", "harmonic", "white_noise", "pink_noise", "chirp", "dc_drift"
+  };
+  return (kind < CORPUS_NUM_KINDS) ? names[kind] : "?";
+}
+
+int corpus_size(int variants) {
+  int total = 0;
+  for (int k = 0; k < CORPUS_NUM_KINDS; k++) {
+    total += kind_count((corpus_kind_t)k);
+  }
+  return total * variants;
+}
+
+void corpus_describe(int index, int variants, corpus_vector_t* v) {
+
+  corpus_kind_t kind = CORPUS_TONE;
+  while (kind < CORPUS_NUM_KINDS - 1 && index >= kind_count(kind) * variants) {
+    index -= kind_count(kind) * variants;
+    kind++;
+  }
+
+  int cell = index / variants;
+  uint32_t seed = 0x9E3779B9u * (uint32_t)(index + 1) + 0x7F4A7C15u * (uint32_t)(kind + 1);
+  uint32_t rng = seed;
+  // keep tones within a quarter bin of the centre so the expected bin is unambiguous
+  double offset_hz = 0.25 * BIN_HZ * rng_uniform(&rng);
+
+  v->kind = kind;
+  v->seed = seed;
+  v->tolerance = 0;
+  v->param = 0.0;
+
+  switch (kind) {
+    case CORPUS_TONE:
+    case CORPUS_CHIRP:
+      v->expected_bin = formants[cell / NLEVELS];
+      v->amplitude_db = tone_levels_db[cell % NLEVELS];
+      v->freq_hz = v->expected_bin * BIN_HZ + offset_hz;
+      if (kind == CORPUS_CHIRP) {
+        v->freq_hz = v->expected_bin * BIN_HZ;
+        v->param = BIN_HZ;      // sweep one bin wide
+        v->tolerance = 1;
+      }
+      break;
+    case CORPUS_HARMONIC:
+      v->expected_bin = formants[cell / NROLLOFF];
+      v->amplitude_db = -10.0;
+      v->freq_hz = v->expected_bin * BIN_HZ + offset_hz;
+      v->param = harmonic_rolloff[cell % NROLLOFF];
+      break;
+    case CORPUS_DC_DRIFT:
+      v->expected_bin = formants[cell / NSLOPES];
+      v->amplitude_db = -10.0;
+      v->freq_hz = v->expected_bin * BIN_HZ + offset_hz;
+      v->param = drift_slopes[cell % NSLOPES];
+      break;
+    default:
+      v->expected_bin = CORPUS_NO_PITCH;
+      v->amplitude_db = -20.0;
+      v->freq_hz = 0.0;
+      break;
+  }
+}
+
+void corpus_render(const corpus_vector_t* v, uint16_t* samples) {
+
+  uint32_t rng = v->seed ^ 0xA5A5A5A5u;
+  double amp = FULL_SCALE * pow(10.0, v->amplitude_db / 20.0);
+  double phase = M_PI * rng_uniform(&rng);
+  // Paul Kellet's economy pink filter state
+  double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+
+  for (int i = 0; i < CORPUS_NSAMPLES; i++) {
+    double t = (double)i / CORPUS_SAMPLING_RATE;
+    double x = 0.0;
+    double bias = 1 << 15;
+
+    switch (v->kind) {
+      case CORPUS_TONE:
+        x = amp * cos(2.0 * M_PI * v->freq_hz * t + phase);
+        break;
+      case CORPUS_HARMONIC: {
+        double gain = 1.0;
+        for (int h = 1; h <= 4; h++) {
+          x += amp * gain * cos(2.0 * M_PI * h * v->freq_hz * t + h * phase);
+          gain *= v->param;
+        }
+        x /= 1.0 + v->param + v->param * v->param;
+        break;
+      }
+      case CORPUS_WHITE_NOISE:
+        x = amp * rng_uniform(&rng);
+        break;
+      case CORPUS_PINK_NOISE: {
+        double white = rng_uniform(&rng);
+        b0 = 0.99765 * b0 + white * 0.0990460;
+        b1 = 0.96300 * b1 + white * 0.2965164;
+        b2 = 0.57000 * b2 + white * 1.0526913;
+        x = amp * (b0 + b1 + b2 + white * 0.1848) / 3.0;
+        break;
+      }
+      case CORPUS_CHIRP: {
+        // instantaneous frequency sweeps freq_hz - param/2 .. freq_hz + param/2
+        double duration = (double)CORPUS_NSAMPLES / CORPUS_SAMPLING_RATE;
+        double f0 = v->freq_hz - v->param / 2.0;
+        x = amp * cos(2.0 * M_PI * (f0 * t + 0.5 * (v->param / duration) * t * t) + phase);
+        break;
+      }
+      case CORPUS_DC_DRIFT:
+        x = amp * cos(2.0 * M_PI * v->freq_hz * t + phase);
+        bias += v->param * ((double)i / CORPUS_NSAMPLES - 0.5);
+        break;
+      default:
+        break;
+    }
+
+    // a couple of LSBs of converter noise on every vector
+    x += 4.0 * rng_uniform(&rng);
+
+    double s = bias + x;
+    if (s < 0.0) s = 0.0;
+    if (s > 65535.0) s = 65535.0;
+    samples[i] = (uint16_t)lrint(s);
+  }
+}
@@ -0,0 +1,76 @@
+/*
+ * @file corpus.h
+ *
+ * @brief	Deterministic golden-vector corpus for the pitch detector
+ *
+ * Every vector is described by a small record and rendered on demand from its
+ * seed, so the corpus costs no disk space and is identical on every machine.
+ * The FORMANT_* constants in dsp_fft.h are FFT bin indices, tones are placed
+ * relative to the bin centre (bin * 8192 / 512 Hz).
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _CORPUS_H_
+#define _CORPUS_H_
+
+#include <stdint.h>
+
+#define CORPUS_NSAMPLES      (512)
+#define CORPUS_SAMPLING_RATE (8192)
+#define CORPUS_NO_PITCH      (-1)
+
+typedef enum {
+  CORPUS_TONE,        // pure tone on a formant bin at several amplitudes
+  CORPUS_HARMONIC,    // formant fundamental plus decaying 2f..4f harmonics
+  CORPUS_WHITE_NOISE, // no pitch expected
+  CORPUS_PINK_NOISE,  // no pitch expected, energy piled into the low bins
+  CORPUS_CHIRP,       // linear sweep across one bin centred on a formant
+  CORPUS_DC_DRIFT,    // tone riding on a ramping mic bias
+  CORPUS_NUM_KINDS
+} corpus_kind_t;
+
+typedef struct {
+  corpus_kind_t kind;
+  int expected_bin;     // FORMANT_* or CORPUS_NO_PITCH
+  int tolerance;        // bins either side still counted as correct
+  double freq_hz;       // fundamental (chirp: centre)
+  double amplitude_db;  // relative to a full scale 16-bit swing
+  double param;         // kind specific: harmonic rolloff, chirp span, drift slope
+  uint32_t seed;        // phase, fractional offset and noise
+} corpus_vector_t;
+
+/* @brief   Number of vectors in the corpus
+ *
+ * @param   variants, random variations per (kind, formant, level), >= 1
+ * @return  corpus size
+ */
+int corpus_size(int variants);
+
+/* @brief   Describes vector index of the corpus
+ *
+ * @param   index, 0 .. corpus_size(variants)-1
+ *          variants, as passed to corpus_size()
+ *          v, filled in
+ * @return  none
+ */
+void corpus_describe(int index, int variants, corpus_vector_t* v);
+
+/* @brief   Renders a vector into ADC counts (uint16_t around 1<<15)
+ *
+ * @param   v, vector description
+ *          samples, CORPUS_NSAMPLES output samples
+ * @return  none
+ */
+void corpus_render(const corpus_vector_t* v, uint16_t* samples);
+
+/* @brief   Short name of a vector kind for reports
+ *
+ * @param   kind
+ * @return  static string
+ */
+const char* corpus_kind_name(corpus_kind_t kind);
+
+#endif // _CORPUS_H_
@@ -0,0 +1,38 @@
+/*
+ * @file host_alloc.c
+ *
+ * @brief	Counts heap allocations, see host_alloc.h
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stddef.h>
+#include "host_alloc.h"
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t nmemb, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+// per thread so parallel runners do not share a hot cache line
+static _Thread_local uint64_t alloc_count;
+
+uint64_t host_alloc_count(void) {
+  return alloc_count;
+}
+
+void* __wrap_malloc(size_t size) {
+  alloc_count++;
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t nmemb, size_t size) {
+  alloc_count++;
+  return __real_calloc(nmemb, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  alloc_count++;
+  return __real_realloc(ptr, size);
+}
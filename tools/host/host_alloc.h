@@ -0,0 +1,24 @@
+/*
+ * @file host_alloc.h
+ *
+ * @brief	Heap allocation counter for the host tools, the Makefile links with
+ * 			-Wl,--wrap so every malloc/calloc/realloc passes through here
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _HOST_ALLOC_H_
+#define _HOST_ALLOC_H_
+
+#include <stdint.h>
+
+/* @brief   Number of heap allocations made by this thread so far
+ *
+ * @param   none
+ * @return  running allocation count
+ */
+uint64_t host_alloc_count(void);
+
+#endif // _HOST_ALLOC_H_
@@ -0,0 +1,37 @@
+/*
+ * @file host_cmsis_shim.c
+ *
+ * @brief	Portable stand-ins for the pieces of CMSIS-DSP that only ship as
+ * 			Cortex-M assembly, so dsp_fft.c links into the host tools
+ *
+ * CMSIS-DSP V1.4.x provides arm_bitreversal_16 in arm_bitreversal2.S only.
+ * The symbol is weak so a newer CMSIS-DSP that has arm_bitreversal2.c wins.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+
+// bit reversal of a complex q15 buffer using the byte offset tables from arm_common_tables.c
+__attribute__((weak))
+void arm_bitreversal_16(uint16_t *pSrc, const uint16_t bitRevLen, const uint16_t *pBitRevTab) {
+
+  uint16_t a, b, tmp;
+
+  for (uint16_t i = 0; i < bitRevLen; i += 2) {
+    a = pBitRevTab[i] >> 2;
+    b = pBitRevTab[i + 1] >> 2;
+
+    // real
+    tmp = pSrc[a];
+    pSrc[a] = pSrc[b];
+    pSrc[b] = tmp;
+
+    // imaginary
+    tmp = pSrc[a + 1];
+    pSrc[a + 1] = pSrc[b + 1];
+    pSrc[b + 1] = tmp;
+  }
+}
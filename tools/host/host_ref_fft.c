@@ -0,0 +1,79 @@
+/*
+ * @file host_ref_fft.c
+ *
+ * @brief	Textbook iterative radix-2 FFT in double precision, kept deliberately
+ * 			simple so it can serve as ground truth for the fixed-point engine
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include "host_ref_fft.h"
+
+#ifndef M_PI
+#define M_PI (3.14159265358979323846)
+#endif
+
+// see .h for more details
+int ref_fft_mag(const uint16_t* samples, int nsamples, double* work, double* mag) {
+
+  if (samples == NULL || work == NULL || mag == NULL ||
+      nsamples < 2 || (nsamples & (nsamples - 1)) != 0) {
+    return -1;
+  }
+
+  // interleaved complex input: bias removed and Hann windowed
+  for (int i = 0; i < nsamples; i++) {
+    double w = 0.5 * (1.0 - cos(2.0 * M_PI * i / (nsamples - 1)));
+    work[2*i]   = ((double)samples[i] - (1 << 15)) * w;
+    work[2*i+1] = 0.0;
+  }
+
+  // bit reversal permutation
+  for (int i = 1, j = 0; i < nsamples; i++) {
+    int bit = nsamples >> 1;
+    for (; j & bit; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+    if (i < j) {
+      double re = work[2*i], im = work[2*i+1];
+      work[2*i]   = work[2*j];
+      work[2*i+1] = work[2*j+1];
+      work[2*j]   = re;
+      work[2*j+1] = im;
+    }
+  }
+
+  // butterflies
+  for (int len = 2; len <= nsamples; len <<= 1) {
+    double ang = -2.0 * M_PI / len;
+    double wr = cos(ang), wi = sin(ang);
+    for (int i = 0; i < nsamples; i += len) {
+      double cr = 1.0, ci = 0.0;
+      for (int k = 0; k < len / 2; k++) {
+        double* a = &work[2*(i + k)];
+        double* b = &work[2*(i + k + len/2)];
+        double tr = b[0]*cr - b[1]*ci;
+        double ti = b[0]*ci + b[1]*cr;
+        b[0] = a[0] - tr;
+        b[1] = a[1] - ti;
+        a[0] += tr;
+        a[1] += ti;
+        double ncr = cr*wr - ci*wi;
+        ci = cr*wi + ci*wr;
+        cr = ncr;
+      }
+    }
+  }
+
+  // power of each bin
+  for (int k = 0; k < nsamples; k++) {
+    mag[k] = work[2*k]*work[2*k] + work[2*k+1]*work[2*k+1];
+  }
+
+  return 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * @file host_ref_fft.h
+ *
+ * @brief	Double precision reference power spectrum used by the host tools to
+ * 			check and time the q15 CMSIS path in dsp_fft.c
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#ifndef _HOST_REF_FFT_H_
+#define _HOST_REF_FFT_H_
+
+#include <stdint.h>
+
+/* @brief   Power spectrum of nsamples ADC counts, Hann windowed, in double precision
+ *
+ * Mirrors dsp_fft_mag(): removes the 1<<15 mic bias, applies a Hann window and
+ * returns |X[k]|^2 for every bin k < nsamples.
+ *
+ * @param   samples,  ADC counts (uint16_t, biased around 1<<15)
+ *          nsamples, power of two transform length
+ *          work,     scratch of 2*nsamples doubles (no allocation inside)
+ *          mag,      output of nsamples doubles
+ *
+ * @return  0 on success, -1 if nsamples is not a power of two
+ */
+int ref_fft_mag(const uint16_t* samples, int nsamples, double* work, double* mag);
+
+#endif // _HOST_REF_FFT_H_
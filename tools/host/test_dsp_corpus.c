@@ -0,0 +1,239 @@
+/*
+ * @file test_dsp_corpus.c
+ *
+ * @brief	Runs the golden-vector corpus (corpus.h) through dsp_fft_mag() and
+ * 			dsp_fft_max_pitch() and reports accuracy per signal kind
+ *
+ * dsp_fft_mag() returns a static buffer, so the corpus is split across forked
+ * worker processes (one per core) rather than threads. Each worker streams a
+ * small result record per vector back over a pipe.
+ *
+ * --dc-block runs dsp_fft_mag_dc() instead, each vector with a fresh tracker
+ * primed from its own mean, which is what the board does on its first frame.
+ *
+ * usage: test_dsp_corpus [--variants N] [--jobs N] [--min-accuracy PCT] [--dc-block] [--json] [--csv]
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <dsp_fft.h>
+#include "corpus.h"
+
+#define DEFAULT_VARIANTS (8)
+
+static int dc_block;
+
+typedef struct {
+  int32_t index;
+  int32_t bin;
+  double ns;
+} corpus_result_t;
+
+typedef struct {
+  int vectors;
+  int correct;
+  int octave_errors;
+  double total_ns;
+  double max_ns;
+} kind_stats_t;
+
+static const int formant_bins[] = {
+  FORMANT_G4, FORMANT_G5, FORMANT_B5, FORMANT_D_SHARP6,
+  FORMANT_E_FLAT7, FORMANT_G7, FORMANT_B7
+};
+
+// whether dsp_fft_pitch_detect() would announce a pitch for this bin
+static int is_formant(int bin) {
+  for (size_t i = 0; i < sizeof(formant_bins)/sizeof(formant_bins[0]); i++) {
+    if (formant_bins[i] == bin) return 1;
+  }
+  return 0;
+}
+
+static int is_correct(const corpus_vector_t* v, int bin) {
+  if (v->expected_bin == CORPUS_NO_PITCH) {
+    return !is_formant(bin);
+  }
+  return abs(bin - v->expected_bin) <= v->tolerance;
+}
+
+static int is_octave_error(const corpus_vector_t* v, int bin) {
+  if (v->expected_bin == CORPUS_NO_PITCH) return 0;
+  return abs(bin - 2*v->expected_bin) <= v->tolerance ||
+         abs(2*bin - v->expected_bin) <= v->tolerance;
+}
+
+static double now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// worker: every jobs-th vector starting at first, results written to fd
+static void run_worker(int first, int jobs, int total, int variants, int fd) {
+
+  uint16_t samples[CORPUS_NSAMPLES];
+  corpus_vector_t v;
+
+  for (int i = first; i < total; i += jobs) {
+    corpus_describe(i, variants, &v);
+    corpus_render(&v, samples);
+
+    dsp_dc_t dc;
+    dsp_dc_reset(&dc);
+    double t0 = now_ns();
+    int16_t* mags = dsp_fft_mag_dc(samples, CORPUS_NSAMPLES, dc_block ? &dc : NULL);
+    int bin = (mags != NULL) ? dsp_fft_max_pitch(mags) : -1;
+    corpus_result_t r = { i, bin, now_ns() - t0 };
+
+    if (write(fd, &r, sizeof(r)) != sizeof(r)) {
+      _exit(1);
+    }
+  }
+  _exit(0);
+}
+
+int main(int argc, char** argv) {
+
+  int variants = DEFAULT_VARIANTS;
+  int jobs = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  double min_accuracy = 0.0;
+  int json = 0, csv = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--variants") && i + 1 < argc) {
+      variants = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--jobs") && i + 1 < argc) {
+      jobs = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--min-accuracy") && i + 1 < argc) {
+      min_accuracy = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--dc-block")) {
+      dc_block = 1;
+    } else if (!strcmp(argv[i], "--json")) {
+      json = 1;
+    } else if (!strcmp(argv[i], "--csv")) {
+      csv = 1;
+    } else {
+      fprintf(stderr, "usage: %s [--variants N] [--jobs N] [--min-accuracy PCT] [--dc-block] [--json] [--csv]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (variants < 1) variants = 1;
+  if (jobs < 1) jobs = 1;
+
+  int total = corpus_size(variants);
+  corpus_result_t* results = calloc(total, sizeof(*results));
+  int* fds = calloc(jobs, sizeof(*fds));
+  pid_t* pids = calloc(jobs, sizeof(*pids));
+  if (results == NULL || fds == NULL || pids == NULL) {
+    fprintf(stderr, "out of memory\n");
+    return 2;
+  }
+
+  double t0 = now_ns();
+  for (int j = 0; j < jobs; j++) {
+    int p[2];
+    if (pipe(p) != 0) {
+      perror("pipe");
+      return 2;
+    }
+    pids[j] = fork();
+    if (pids[j] < 0) {
+      perror("fork");
+      return 2;
+    }
+    if (pids[j] == 0) {
+      close(p[0]);
+      run_worker(j, jobs, total, variants, p[1]);
+    }
+    close(p[1]);
+    fds[j] = p[0];
+  }
+
+  // a worker blocked on a full pipe just waits until we get to it
+  int received = 0;
+  for (int j = 0; j < jobs; j++) {
+    corpus_result_t r;
+    while (read(fds[j], &r, sizeof(r)) == sizeof(r)) {
+      if (r.index >= 0 && r.index < total) {
+        results[r.index] = r;
+        received++;
+      }
+    }
+    close(fds[j]);
+    waitpid(pids[j], NULL, 0);
+  }
+  double wall_ms = (now_ns() - t0) / 1e6;
+
+  if (received != total) {
+    fprintf(stderr, "only %d of %d vectors came back from the workers\n", received, total);
+    return 2;
+  }
+
+  kind_stats_t stats[CORPUS_NUM_KINDS + 1];
+  memset(stats, 0, sizeof(stats));
+  kind_stats_t* all = &stats[CORPUS_NUM_KINDS];
+
+  if (csv) {
+    printf("index,kind,freq_hz,amplitude_db,param,expected_bin,bin,correct,ns\n");
+  }
+  for (int i = 0; i < total; i++) {
+    corpus_vector_t v;
+    corpus_describe(i, variants, &v);
+    int ok = is_correct(&v, results[i].bin);
+    int octave = !ok && is_octave_error(&v, results[i].bin);
+
+    kind_stats_t* group[2] = { &stats[v.kind], all };
+    for (int g = 0; g < 2; g++) {
+      group[g]->vectors++;
+      group[g]->correct += ok;
+      group[g]->octave_errors += octave;
+      group[g]->total_ns += results[i].ns;
+      if (results[i].ns > group[g]->max_ns) group[g]->max_ns = results[i].ns;
+    }
+    if (csv) {
+      printf("%d,%s,%.2f,%.1f,%.2f,%d,%d,%d,%.0f\n", i, corpus_kind_name(v.kind), v.freq_hz,
+             v.amplitude_db, v.param, v.expected_bin, results[i].bin, ok, results[i].ns);
+    }
+  }
+
+  double accuracy = 100.0 * all->correct / all->vectors;
+
+  if (json) {
+    printf("{\n  \"vectors\": %d,\n  \"jobs\": %d,\n  \"wall_ms\": %.1f,\n  \"kinds\": [\n", total, jobs, wall_ms);
+    for (int k = 0; k <= CORPUS_NUM_KINDS; k++) {
+      kind_stats_t* s = &stats[k];
+      printf("    {\"kind\": \"%s\", \"vectors\": %d, \"accuracy_pct\": %.2f, \"octave_error_pct\": %.2f, "
+             "\"mean_ns\": %.0f, \"max_ns\": %.0f}%s\n",
+             k < CORPUS_NUM_KINDS ? corpus_kind_name((corpus_kind_t)k) : "all", s->vectors,
+             100.0 * s->correct / s->vectors, 100.0 * s->octave_errors / s->vectors,
+             s->total_ns / s->vectors, s->max_ns, k < CORPUS_NUM_KINDS ? "," : "");
+    }
+    printf("  ]\n}\n");
+  } else if (!csv) {
+    printf("%-12s %8s %9s %9s %10s %10s\n", "kind", "vectors", "accuracy", "octave", "mean ns", "max ns");
+    for (int k = 0; k <= CORPUS_NUM_KINDS; k++) {
+      kind_stats_t* s = &stats[k];
+      printf("%-12s %8d %8.2f%% %8.2f%% %10.0f %10.0f\n",
+             k < CORPUS_NUM_KINDS ? corpus_kind_name((corpus_kind_t)k) : "all", s->vectors,
+             100.0 * s->correct / s->vectors, 100.0 * s->octave_errors / s->vectors,
+             s->total_ns / s->vectors, s->max_ns);
+    }
+    printf("\n%d vectors on %d workers in %.1f ms\n", total, jobs, wall_ms);
+  }
+
+  if (accuracy < min_accuracy) {
+    fprintf(stderr, "FAIL: accuracy %.2f%% below %.2f%%\n", accuracy, min_accuracy);
+    return 1;
+  }
+  return 0;
+}
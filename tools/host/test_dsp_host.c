@@ -0,0 +1,41 @@
+/*
+ * @file test_dsp_host.c
+ *
+ * @brief	Host runner for the on-target unit tests and the boot self-test
+ *
+ * Runs test_dsp() (source/test_dsp_fft.c) unchanged, its asserts abort the
+ * process on failure, then prints the CRC dsp_selftest() expects so it can be
+ * recorded as DSP_SELFTEST_CRC. The CMSIS-DSP C sources are the same on both
+ * sides, so the host CRC matches the device.
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdio.h>
+#include <dsp_selftest.h>
+#include <test_dsp_fft.h>
+
+#define EXPECTED_UNIT_TESTS (5)
+
+int main(void) {
+
+  int passed = test_dsp();
+  printf("Number of passing Unit Tests %d/%d\n", passed, EXPECTED_UNIT_TESTS);
+
+  uint16_t crc = dsp_selftest_crc();
+  printf("dsp_selftest_crc = 0x%04X (DSP_SELFTEST_CRC = 0x%04X)\n", crc, DSP_SELFTEST_CRC);
+
+  if (passed != EXPECTED_UNIT_TESTS) {
+    return 1;
+  }
+  if (!dsp_selftest()) {
+    printf("FAIL: self-test spectrum is off or its CRC changed, re-record DSP_SELFTEST_CRC if the new output is intended\n");
+    return 1;
+  }
+  if (DSP_SELFTEST_CRC == 0) {
+    printf("DSP_SELFTEST_CRC is not recorded, set it to 0x%04X in dsp_selftest.h to compare bit for bit\n", crc);
+  }
+  return 0;
+}
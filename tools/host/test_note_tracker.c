@@ -0,0 +1,97 @@
+/*
+ * @file test_note_tracker.c
+ *
+ * @brief	Runs the note tracker (note_tracker.h) over scripted bin sequences and
+ * 			checks the note-on/note-off events it reports
+ *
+ * Each scenario is a list of frames: a bin, or 0 for an unvoiced frame. The
+ * expected events are written as "+bin@frame" for note-on and "-bin@frame"
+ * for note-off, where frame is the index of the frame that produced it.
+ * Scenarios cover a held note, one-frame flicker to a neighbour, an octave
+ * slip at the onset, a dropout, a note change and a melody with a noisy
+ * detector. Any difference fails the run.
+ *
+ * usage: test_note_tracker [-v]
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <note_tracker.h>
+
+#define MAX_FRAMES (64)
+
+typedef struct {
+  const char* name;
+  int frames[MAX_FRAMES];   // bin per frame, 0 unvoiced, -1 ends the list
+  const char* expect;       // events, e.g. "+7@2 -7@9"
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+  { "held note",
+    { 0, 7, 7, 7, 7, 7, 7, 7, 0, 0, 0, 0, -1 },
+    "+7@3 -7@10" },
+  { "neighbour flicker",
+    { 7, 7, 7, 8, 7, 7, 6, 7, 7, 8, 7, 7, 0, 0, 0, 0, -1 },
+    "+7@2 -7@14" },
+  { "octave slip at onset",
+    { 14, 7, 7, 7, 7, 7, 7, 0, 0, 0, 0, -1 },
+    "+7@3 -7@9" },
+  { "one frame dropout",
+    { 12, 12, 12, 12, 0, 12, 12, 12, 12, 0, 0, 0, 0, -1 },
+    "+12@2 -12@11" },
+  { "note change",
+    { 5, 5, 5, 5, 5, 5, 20, 20, 20, 20, 20, 20, 0, 0, 0, 0, -1 },
+    "+5@2 -5@8 +20@8 -20@14" },
+  { "noisy melody",
+    { 10, 10, 25, 10, 10, 10, 10, 15, 15, 30, 15, 15, 15, 15, 0, 20, 20, 20, 20, 20, 20,
+      0, 0, 0, 0, -1 },
+    "+10@2 -10@9 +15@9 -15@17 +20@17 -20@23" },
+  { "isolated blips",
+    { 0, 9, 0, 0, 17, 0, 0, 0, 31, 0, 0, 0, -1 },
+    "" },
+};
+#define NSCENARIOS ((int)(sizeof(scenarios)/sizeof(scenarios[0])))
+
+// runs one scenario, the events go to out as "+bin@frame -bin@frame ..."
+static void run(const scenario_t* sc, char* out, size_t size) {
+  note_tracker_t t;
+  note_event_t events[2];
+  size_t len = 0;
+
+  out[0] = '\0';
+  note_tracker_init(&t);
+  for (int f = 0; f < MAX_FRAMES && sc->frames[f] >= 0; f++) {
+    int bin = sc->frames[f];
+    uint32_t n = note_tracker_update(&t, (uint16_t)bin, bin != 0, events);
+    for (uint32_t i = 0; i < n && len < size; i++) {
+      len += snprintf(out + len, size - len, "%s%c%d@%d", (len > 0) ? " " : "",
+                      (events[i].type == NOTE_EVENT_ON) ? '+' : '-', events[i].bin, f);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  bool verbose = (argc > 1 && !strcmp(argv[1], "-v"));
+  int failed = 0;
+
+  printf("note tracker: %d states, hold %d, %u bytes of state\n", NOTE_TRACK_STATES,
+         NOTE_TRACK_HOLD, (unsigned)sizeof(note_tracker_t));
+  for (int s = 0; s < NSCENARIOS; s++) {
+    char got[256];
+    run(&scenarios[s], got, sizeof(got));
+    bool ok = !strcmp(got, scenarios[s].expect);
+    failed += !ok;
+    if (!ok || verbose) {
+      printf("%-22s %s  got \"%s\"", scenarios[s].name, ok ? "ok  " : "FAIL", got);
+      printf(ok ? "\n" : ", expected \"%s\"\n", scenarios[s].expect);
+    }
+  }
+  printf("%d/%d scenarios pass\n", NSCENARIOS - failed, NSCENARIOS);
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * @file test_tuner.c
+ *
+ * @brief	Checks the chromatic tuner (tuner.h) on synthesized tones across its
+ * 			60 Hz .. 4 kHz range
+ *
+ * Every equal tempered note from B1 (61.7 Hz) to B7 (3951 Hz) is rendered at
+ * offsets of -30, -10, 0, +10 and +30 cents, where that is inside 60 Hz ..
+ * 4 kHz, as 512 ADC counts at 8192 Hz with white noise (--noise, LSB rms),
+ * optionally with a 2nd harmonic 6 dB above the fundamental (--harmonic). The power spectrum comes from the double precision
+ * reference (host_ref_fft.h) scaled to the q15 units of dsp_fft_mag(), |X|^2 /
+ * 2^35 rounded to int16, so a full scale sine peaks near 512 as on the board.
+ *
+ * The report gives, per octave, the notes named wrong and the mean and largest
+ * cents error. It also checks tuner_log2_q15() against log2() over 1 .. 2^20.
+ * A wrong note or a log2 error of a cent or more fails the run.
+ *
+ * usage: test_tuner [--level DBFS] [--noise LSB] [--harmonic] [-v]
+ *
+ * @author	Ishmael Pelayo
+ * @date	2026-10-18
+ * @version 1.0
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tuner.h>
+#include "host_ref_fft.h"
+
+#ifndef M_PI
+#define M_PI (3.14159265358979323846)
+#endif
+
+#define NSAMPLES      (512)
+#define SAMPLING_RATE (8192)
+#define FULL_SCALE    (32767.0)
+#define MIDI_FIRST    (35)      // B1
+#define MIDI_LAST     (107)     // B7
+// dsp_fft_mag(): the 512 point q15 rfft is scaled by 2^-9, the squared magnitude by 2^-17
+#define Q15_POWER_SCALE (1.0 / 34359738368.0)
+
+static const int offsets[] = { -30, -10, 0, 10, 30 };
+#define NOFFSETS ((int)(sizeof(offsets)/sizeof(offsets[0])))
+
+static uint32_t rng_state = 0x2545F491U;
+
+// xorshift32
+static uint32_t rng_next(void) {
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return rng_state = x;
+}
+
+// standard normal, Box-Muller
+static double rng_gauss(void) {
+  double u1 = (rng_next() + 1.0) / 4294967297.0;
+  double u2 = rng_next() / 4294967296.0;
+  return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// one frame of the tone in the power units of dsp_fft_mag()
+static void render(double freq, double level_db, double noise, int harmonic, int16_t* power) {
+  static double work[2 * NSAMPLES], mag[NSAMPLES];
+  uint16_t frame[NSAMPLES];
+  double amp = FULL_SCALE * pow(10.0, level_db / 20.0);
+  double phase = 2.0 * M_PI * (rng_next() / 4294967296.0);
+
+  for (int i = 0; i < NSAMPLES; i++) {
+    double t = (double)i / SAMPLING_RATE;
+    double v = (harmonic ? 0.5 : 1.0) * amp * sin(2.0 * M_PI * freq * t + phase);
+    if (harmonic && 2.0 * freq < SAMPLING_RATE / 2) {
+      v += amp * sin(4.0 * M_PI * freq * t);
+    }
+    v = floor((1 << 15) + v + noise * rng_gauss() + 0.5);
+    frame[i] = (uint16_t)((v < 0) ? 0 : (v > 65535) ? 65535 : v);
+  }
+  ref_fft_mag(frame, NSAMPLES, work, mag);
+  for (int k = 0; k < NSAMPLES / 2 + 1; k++) {
+    double p = floor(mag[k] * Q15_POWER_SCALE + 0.5);
+    power[k] = (int16_t)((p > INT16_MAX) ? INT16_MAX : p);
+  }
+}
+
+// largest error of tuner_log2_q15() in cents (1/1200 octave)
+static double log2_error_cents(void) {
+  double worst = 0;
+  for (uint32_t x = 1; x <= (1U << 20); x++) {
+    double err = fabs(tuner_log2_q15(x) / 32768.0 - log2((double)x)) * 1200.0;
+    if (err > worst) worst = err;
+  }
+  return worst;
+}
+
+int main(int argc, char** argv) {
+  double level = -6.0, noise = 8.0;
+  int harmonic = 0, verbose = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--harmonic")) harmonic = 1;
+    else if (!strcmp(argv[i], "-v")) verbose = 1;
+    else if (!strcmp(argv[i], "--level") && i + 1 < argc) level = atof(argv[++i]);
+    else if (!strcmp(argv[i], "--noise") && i + 1 < argc) noise = atof(argv[++i]);
+    else {
+      fprintf(stderr, "usage: test_tuner [--level DBFS] [--noise LSB] [--harmonic] [-v]\n");
+      return 2;
+    }
+  }
+
+  double log_err = log2_error_cents();
+  printf("tuner_log2_q15: largest error %.2f cents over 1 .. 2^20\n", log_err);
+  printf("tones at %.0f dBFS, noise %.1f LSB rms%s\n", level, noise,
+         harmonic ? ", 2nd harmonic 6 dB above the fundamental" : "");
+  printf("octave  tones  wrong  mean |cents err|  max |cents err|\n");
+
+  int16_t power[NSAMPLES / 2 + 1];
+  int wrong_total = 0;
+  for (int octave = 1; octave <= 7; octave++) {
+    int tones = 0, wrong = 0;
+    double sum = 0, worst = 0;
+    for (int midi = MIDI_FIRST; midi <= MIDI_LAST; midi++) {
+      if ((midi / 12) - 1 != octave) {
+        continue;
+      }
+      for (int o = 0; o < NOFFSETS; o++) {
+        double freq = TUNER_A4_HZ * pow(2.0, (midi - 69 + offsets[o] / 100.0) / 12.0);
+        tuner_note_t note;
+        if (freq < 60.0 || freq > 4000.0) {
+          continue;
+        }
+        render(freq, level, noise, harmonic, power);
+        tones++;
+        if (!tuner_estimate(power, 1, &note) || note.midi != midi) {
+          wrong++;
+          if (verbose) {
+            printf("  %.1f Hz (midi %d %+d cents): got midi %d\n", freq, midi, offsets[o],
+                   tuner_estimate(power, 1, &note) ? note.midi : -1);
+          }
+          continue;
+        }
+        double err = fabs((double)note.cents - offsets[o]);
+        sum += err;
+        if (err > worst) worst = err;
+      }
+    }
+    wrong_total += wrong;
+    printf("%6d %6d %6d %18.1f %16.0f\n", octave, tones, wrong,
+           (tones > wrong) ? sum / (tones - wrong) : 0.0, worst);
+  }
+  return (wrong_total > 0 || log_err >= 1.0) ? 1 : 0;
+}
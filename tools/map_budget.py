@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+"""
+map_budget.py - per-module flash/RAM budget report from a GNU ld map file
+
+Reads the .map the MCUXpresso link step writes (Debug/ECEN5813_FinalProject.map)
+and prints .text/.rodata/.data/.bss for every object file, plus the heap and
+stack reservations from the managed linker script and the SRAM headroom left.
+
+Exits 1 when static RAM + heap + stack passes --max-ram (default 90% of SRAM)
+or when a module passes its own --budget, so it can run as a post-build check:
+
+    map_budget.py Debug/ECEN5813_FinalProject.map --budget dsp_fft.o=2048
+
+Functions copied to SRAM (.ramfunc.<name> / RamFunction input sections in
+.data, see dsp_fft.h) are listed one by one. --ramfunc-max fails on any of
+them above the given size, --ramfunc-budget NAME=BYTES on one function.
+
+@author  Ishmael Pelayo
+@date    2026-10-18
+"""
+
+import argparse
+import os
+import re
+import sys
+from collections import defaultdict
+
+# output sections that hold zero-initialised or uninitialised RAM
+NOINIT_SECTIONS = (".noinit", ".mtb_buffer_default", ".uninit_RESERVED", ".m_usb_data")
+
+INPUT_ONE_LINE = re.compile(r"^ (\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+INPUT_NAME_ONLY = re.compile(r"^ (\S+)$")
+INPUT_CONT = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+OUTPUT_SECTION = re.compile(r"^(\.\S+|\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+))?")
+MEMORY_REGION = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+ASSIGN = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+(_HeapSize|_StackSize)\s*=")
+
+
+def module_name(path):
+    """./source/dsp_fft.o -> dsp_fft.o, /x/libc.a(foo.o) -> libc.a"""
+    m = re.match(r"(.*\.a)\((.*)\)$", path)
+    if m:
+        return os.path.basename(m.group(1))
+    return os.path.basename(path)
+
+
+def classify(out_sect, in_sect):
+    if out_sect == ".text":
+        if in_sect.startswith((".rodata", ".constdata", ".FlashConfig")):
+            return "rodata"
+        return "text"
+    if out_sect in (".ARM.extab", ".ARM.exidx"):
+        return "rodata"
+    if out_sect == ".data":
+        return "data"
+    if out_sect == ".bss":
+        return "bss"
+    if out_sect in NOINIT_SECTIONS:
+        return "noinit"
+    return None
+
+
+def ramfunc_name(out_sect, in_sect, module):
+    """.ramfunc.dsp_fft_mag in .data -> dsp_fft_mag, None for anything else"""
+    if out_sect != ".data":
+        return None
+    if in_sect.startswith(".ramfunc."):
+        return in_sect[len(".ramfunc."):]
+    if in_sect in (".ramfunc", "RamFunction", "CodeQuickAccess"):
+        return "%s(%s)" % (in_sect, module)
+    return None
+
+
+def parse(path):
+    modules = defaultdict(lambda: defaultdict(int))
+    ramfuncs = defaultdict(int)
+    regions = {}
+    reserves = {}
+
+    def add(in_sect, obj, size):
+        kind = classify(out_sect, in_sect)
+        if kind:
+            modules[module_name(obj)][kind] += size
+        name = ramfunc_name(out_sect, in_sect, module_name(obj))
+        if name:
+            ramfuncs[name] += size
+
+    with open(path, errors="replace") as f:
+        lines = f.read().splitlines()
+
+    i = 0
+    # memory regions are listed before the map proper
+    while i < len(lines) and not lines[i].startswith("Linker script and memory map"):
+        if lines[i].startswith("Memory Configuration"):
+            i += 3
+            while i < len(lines) and lines[i].strip():
+                m = MEMORY_REGION.match(lines[i])
+                if m and m.group(1) != "*default*":
+                    regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+                i += 1
+            continue
+        i += 1
+
+    out_sect = None
+    pending = None
+    for line in lines[i:]:
+        m = ASSIGN.match(line)
+        if m:
+            reserves[m.group(2)] = int(m.group(1), 16)
+            continue
+        if pending is not None:
+            m = INPUT_CONT.match(line)
+            if m:
+                add(pending, m.group(3), int(m.group(2), 16))
+            pending = None
+            continue
+        if line and not line[0].isspace():
+            m = OUTPUT_SECTION.match(line)
+            out_sect = m.group(1) if m else None
+            continue
+        if line.startswith(" *") or line.startswith(" FILL"):
+            continue
+        m = INPUT_ONE_LINE.match(line)
+        if m:
+            add(m.group(1), m.group(4), int(m.group(3), 16))
+            continue
+        m = INPUT_NAME_ONLY.match(line)
+        if m:
+            pending = m.group(1)
+
+    return modules, ramfuncs, regions, reserves
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("mapfile")
+    ap.add_argument("--ram-region", default="SRAM")
+    ap.add_argument("--max-ram", type=int, default=None,
+                    help="fail above this many bytes of RAM (default 90%% of the region)")
+    ap.add_argument("--budget", action="append", default=[], metavar="MODULE=BYTES",
+                    help="fail when MODULE uses more than BYTES of RAM (.data+.bss+noinit)")
+    ap.add_argument("--ramfunc-max", type=int, default=None, metavar="BYTES",
+                    help="fail when any function copied to SRAM is larger than BYTES")
+    ap.add_argument("--ramfunc-budget", action="append", default=[], metavar="NAME=BYTES",
+                    help="fail when the SRAM copy of function NAME is larger than BYTES")
+    args = ap.parse_args()
+
+    modules, ramfuncs, regions, reserves = parse(args.mapfile)
+    if args.ram_region not in regions:
+        sys.exit("map_budget: no %s region in %s" % (args.ram_region, args.mapfile))
+    ram_len = regions[args.ram_region][1]
+    max_ram = args.max_ram if args.max_ram is not None else ram_len * 9 // 10
+
+    cols = ("text", "rodata", "data", "bss", "noinit")
+    totals = defaultdict(int)
+    print("%-28s %8s %8s %8s %8s %8s %8s" % (("module",) + cols + ("ram",)))
+    for name in sorted(modules, key=lambda n: -(modules[n]["data"] + modules[n]["bss"] + modules[n]["noinit"])):
+        mod = modules[name]
+        ram = mod["data"] + mod["bss"] + mod["noinit"]
+        for c in cols:
+            totals[c] += mod[c]
+        print("%-28s %8d %8d %8d %8d %8d %8d" % ((name,) + tuple(mod[c] for c in cols) + (ram,)))
+
+    static_ram = totals["data"] + totals["bss"] + totals["noinit"]
+    heap = reserves.get("_HeapSize", 0)
+    stack = reserves.get("_StackSize", 0)
+    used = static_ram + heap + stack
+    print("%-28s %8d %8d %8d %8d %8d %8d" % (("TOTAL",) + tuple(totals[c] for c in cols) + (static_ram,)))
+    print()
+    print("flash : %d of %d bytes" % (totals["text"] + totals["rodata"] + totals["data"],
+                                      regions.get("PROGRAM_FLASH", (0, 0))[1]))
+    print("ram   : %d static + %d heap + %d stack = %d of %d bytes (limit %d)"
+          % (static_ram, heap, stack, used, ram_len, max_ram))
+    print("headroom below limit: %d bytes" % (max_ram - used))
+    if ramfuncs:
+        print()
+        print("%-36s %8s" % ("code in SRAM", "bytes"))
+        for name in sorted(ramfuncs, key=lambda n: -ramfuncs[n]):
+            print("%-36s %8d" % (name, ramfuncs[name]))
+        print("%-36s %8d" % ("TOTAL", sum(ramfuncs.values())))
+
+    failures = []
+    if used > max_ram:
+        failures.append("RAM %d bytes exceeds limit %d" % (used, max_ram))
+    for spec in args.budget:
+        name, _, limit = spec.partition("=")
+        mod = modules.get(name, {})
+        ram = mod.get("data", 0) + mod.get("bss", 0) + mod.get("noinit", 0)
+        if ram > int(limit, 0):
+            failures.append("%s uses %d bytes of RAM, budget %s" % (name, ram, limit))
+    limits = {}
+    for spec in args.ramfunc_budget:
+        name, _, limit = spec.partition("=")
+        limits[name] = int(limit, 0)
+    for name, size in ramfuncs.items():
+        limit = limits.get(name, args.ramfunc_max)
+        if limit is not None and size > limit:
+            failures.append("%s is %d bytes in SRAM, budget %d" % (name, size, limit))
+
+    for msg in failures:
+        print("FAIL: " + msg)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""
+mtb_decode.py - hot function / hot loop report from an MTB branch trace
+
+Reads the "MTB <src> <dst>" lines that mtb_trace_dump() prints (a raw console
+log is fine, other lines are skipped) and the .axf the firmware was built from.
+Every packet is one taken branch, so the code between a packet's destination
+and the next packet's source ran straight through. That gives an instruction
+estimate (Thumb, 2 bytes each) per function, and every backward branch inside
+a function is a loop whose iterations are counted.
+
+usage: mtb_decode.py Debug/ECEN5813_FinalProject.axf console.log [--top 15] [--json]
+
+@author  Ishmael Pelayo
+@date    2026-10-18
+"""
+
+import argparse
+import bisect
+import json
+import re
+import struct
+import sys
+from collections import defaultdict
+
+PACKET = re.compile(r"MTB ([0-9a-fA-F]{8}) ([0-9a-fA-F]{8})")
+
+STT_FUNC = 2
+
+
+def read_functions(path):
+    """Function symbols from the ELF .symtab as a sorted list of (start, end, name)."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF":
+        sys.exit("mtb_decode: %s is not an ELF file" % path)
+    is64 = elf[4] == 2
+    end = "<" if elf[5] == 1 else ">"
+
+    if is64:
+        shoff, = struct.unpack_from(end + "Q", elf, 0x28)
+        shentsize, shnum = struct.unpack_from(end + "HH", elf, 0x3A)
+    else:
+        shoff, = struct.unpack_from(end + "I", elf, 0x20)
+        shentsize, shnum = struct.unpack_from(end + "HH", elf, 0x2E)
+
+    sections = []
+    for i in range(shnum):
+        base = shoff + i * shentsize
+        if is64:
+            _, stype, _, _, off, size, link, _, _, entsize = struct.unpack_from(end + "IIQQQQIIQQ", elf, base)
+        else:
+            _, stype, _, _, off, size, link, _, _, entsize = struct.unpack_from(end + "IIIIIIIIII", elf, base)
+        sections.append((stype, off, size, link, entsize))
+
+    funcs = []
+    for stype, off, size, link, entsize in sections:
+        if stype != 2:  # SHT_SYMTAB
+            continue
+        stroff = sections[link][1]
+        for k in range(size // entsize):
+            base = off + k * entsize
+            if is64:
+                name_off, info, _, _, value, sym_size = struct.unpack_from(end + "IBBHQQ", elf, base)
+            else:
+                name_off, value, sym_size, info, _, _ = struct.unpack_from(end + "IIIBBH", elf, base)
+            if info & 0xF != STT_FUNC or value == 0:
+                continue
+            name_end = elf.index(b"\0", stroff + name_off)
+            name = elf[stroff + name_off:name_end].decode(errors="replace")
+            start = value & ~1  # Thumb bit
+            funcs.append((start, start + max(sym_size, 2), name))
+
+    funcs.sort()
+    return funcs
+
+
+class Symbolizer:
+    def __init__(self, funcs):
+        self.funcs = funcs
+        self.starts = [f[0] for f in funcs]
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i >= 0 and addr < self.funcs[i][1]:
+            return self.funcs[i]
+        return None
+
+
+def read_packets(path):
+    packets = []
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = PACKET.search(line)
+            if m:
+                packets.append((int(m.group(1), 16), int(m.group(2), 16)))
+    return packets
+
+
+def analyse(packets, sym):
+    instrs = defaultdict(int)
+    entries = defaultdict(int)
+    loops = defaultdict(int)
+    total = 0
+
+    for i, (src_word, dst_word) in enumerate(packets):
+        src, dst = src_word & ~1, dst_word & ~1
+        src_fn = sym.lookup(src)
+        dst_fn = sym.lookup(dst)
+
+        if dst_fn and dst == dst_fn[0]:
+            entries[dst_fn[2]] += 1
+
+        # a backward branch that stays inside one function closes a loop
+        if src_fn and src_fn is dst_fn and dst <= src:
+            loops[(src_fn[2], dst, src)] += 1
+
+        # straight-line run from this destination to the next branch source
+        if i + 1 < len(packets):
+            next_src_word, next_dst_word = packets[i + 1]
+            if next_dst_word & 1:
+                continue  # S bit: tracing restarted, the runs do not connect
+            next_src = next_src_word & ~1
+            if dst_fn and dst <= next_src < dst_fn[1]:
+                n = (next_src - dst) // 2 + 1
+                instrs[dst_fn[2]] += n
+                total += n
+
+    return instrs, entries, loops, total
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("axf")
+    ap.add_argument("trace")
+    ap.add_argument("--top", type=int, default=15)
+    ap.add_argument("--json", action="store_true", help="machine readable output")
+    args = ap.parse_args()
+
+    sym = Symbolizer(read_functions(args.axf))
+    packets = read_packets(args.trace)
+    if not packets:
+        sys.exit("mtb_decode: no MTB packets in %s" % args.trace)
+    instrs, entries, loops, total = analyse(packets, sym)
+
+    hot_funcs = sorted(instrs.items(), key=lambda kv: -kv[1])[:args.top]
+    hot_loops = sorted(loops.items(), key=lambda kv: -kv[1] * ((kv[0][2] - kv[0][1]) // 2 + 1))[:args.top]
+
+    if args.json:
+        json.dump({
+            "packets": len(packets),
+            "instructions": total,
+            "functions": [{"name": n, "instructions": c, "entries": entries.get(n, 0)} for n, c in hot_funcs],
+            "loops": [{"function": f, "start": "0x%08x" % s, "end": "0x%08x" % e,
+                       "iterations": c, "body_instructions": (e - s) // 2 + 1} for (f, s, e), c in hot_loops],
+        }, sys.stdout, indent=2)
+        print()
+        return 0
+
+    print("%d packets, ~%d instructions traced\n" % (len(packets), total))
+    print("%-32s %10s %7s %8s" % ("hot functions", "instrs", "share", "entries"))
+    for name, count in hot_funcs:
+        print("%-32s %10d %6.1f%% %8d" % (name, count, 100.0 * count / max(total, 1), entries.get(name, 0)))
+    print()
+    print("%-32s %-23s %10s %6s" % ("hot loops", "range", "iters", "body"))
+    for (name, start, end), count in hot_loops:
+        print("%-32s 0x%08x-0x%08x %10d %6d" % (name, start, end, count, (end - start) // 2 + 1))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
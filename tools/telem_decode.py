@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""
+telem_decode.py - telemetry capture to JSON lines or CSV
+
+Reads the console capture (a file, or - for stdin behind the serial port) and
+decodes the records source/telemetry.c sends, see telemetry.py.
+
+    telem_decode.py capture.bin                      one JSON object per record
+    telem_decode.py capture.bin --csv --type pitch   frame,seq,bin,hz,magnitude
+    telem_decode.py capture.bin --csv --type peaks   frame,seq,rank,bin,hz,magnitude
+    telem_decode.py capture.bin --csv --type spectrum
+    telem_decode.py capture.bin --csv --type counters
+    telem_decode.py dump.bin --csv --type capture     flash log dump: frame,seq,kind,bin,magnitude,first_sample,samples...
+    telem_decode.py dump.bin --csv --type frames      captured ADC blocks decoded: frame,codec,bytes,samples...
+    telem_decode.py dump.bin --type frames --raw f.bin  the same blocks as raw uint16 for tools/host/replay_frames
+
+Bin frequencies use --fs and --n (8192 Hz and 512 points by default). With
+--stats the record, loss and bad frame counts go to stderr at the end.
+
+@author  Ishmael Pelayo
+@date    2026-10-18
+"""
+
+import argparse
+import csv
+import json
+import struct
+import sys
+
+from telemetry import COUNTER_NAMES, read_frames, read_records
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("capture", help="raw console capture, - for stdin")
+    ap.add_argument("--csv", action="store_true", help="CSV for one record --type instead of JSON lines")
+    ap.add_argument("--type", default="pitch", choices=("pitch", "peaks", "spectrum", "counters", "capture", "frames"))
+    ap.add_argument("--raw", metavar="FILE", help="with --type frames, write the decoded blocks as raw uint16 LE")
+    ap.add_argument("--text", action="store_true", help="include console text in the JSON output")
+    ap.add_argument("--fs", type=float, default=8192.0, help="sample rate in Hz")
+    ap.add_argument("--n", type=int, default=512, help="FFT length")
+    ap.add_argument("--stats", action="store_true")
+    args = ap.parse_args()
+
+    hz_per_bin = args.fs / args.n
+    stream = sys.stdin.buffer if args.capture == "-" else open(args.capture, "rb")
+    stats = {}
+    writer = csv.writer(sys.stdout) if args.csv else None
+    header_done = False
+
+    if args.type == "frames":
+        frame_stats = {}
+        raw = open(args.raw, "wb") if args.raw else None
+        for fr in read_frames(read_records(stream, stats), args.n, frame_stats):
+            if raw:
+                raw.write(struct.pack("<%dH" % len(fr["samples"]), *fr["samples"]))
+            elif args.csv:
+                if not header_done:
+                    writer.writerow(["frame", "codec", "bytes", "samples"])
+                    header_done = True
+                writer.writerow([fr["frame"], fr["codec"], fr["bytes"]] + fr["samples"])
+            else:
+                json.dump(fr, sys.stdout)
+                sys.stdout.write("\n")
+        if args.stats:
+            sys.stderr.write("%(frames)d frames, %(broken_frames)d broken\n" % frame_stats)
+        return 0
+
+    for rec in read_records(stream, stats):
+        if not args.csv:
+            if rec["type"] == "text" and not args.text:
+                continue
+            if rec["type"] == "pitch":
+                rec["hz"] = rec["bin"] * hz_per_bin
+            json.dump(rec, sys.stdout)
+            sys.stdout.write("\n")
+            continue
+
+        if rec["type"] != args.type:
+            continue
+        if args.type == "pitch":
+            if not header_done:
+                writer.writerow(["frame", "seq", "bin", "hz", "magnitude"])
+            writer.writerow([rec["frame"], rec["seq"], rec["bin"], rec["bin"] * hz_per_bin, rec["magnitude"]])
+        elif args.type == "peaks":
+            if not header_done:
+                writer.writerow(["frame", "seq", "rank", "bin", "hz", "magnitude"])
+            for rank, p in enumerate(rec["peaks"]):
+                writer.writerow([rec["frame"], rec["seq"], rank, p["bin"], p["bin"] * hz_per_bin, p["magnitude"]])
+        elif args.type == "spectrum":
+            if not header_done:
+                writer.writerow(["frame", "seq"] + ["bin_%d" % i for i in range(len(rec["magnitudes"]))])
+            writer.writerow([rec["frame"], rec["seq"]] + rec["magnitudes"])
+        elif args.type == "capture":
+            if not header_done:
+                writer.writerow(["frame", "seq", "kind", "bin", "magnitude", "first_sample", "samples"])
+            writer.writerow([rec["frame"], rec["seq"], rec["kind"], rec.get("bin", ""), rec.get("magnitude", ""),
+                             rec.get("first_sample", "")] + rec.get("samples", []))
+        else:
+            names = COUNTER_NAMES + sorted(k for k in rec if k.startswith("counter_"))
+            if not header_done:
+                writer.writerow(["frame", "seq"] + names)
+            writer.writerow([rec["frame"], rec["seq"]] + [rec.get(k, "") for k in names])
+        header_done = True
+        sys.stdout.flush()
+
+    if args.stats:
+        sys.stderr.write("%(records)d records, %(lost)d lost, %(bad_frames)d bad frames, "
+                         "%(text_bytes)d text bytes\n" % stats)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,287 @@
+"""
+telemetry.py - decoder for the COBS framed records from source/telemetry.c
+
+Library side of tools/telem_decode.py, importable from other scripts:
+
+    from telemetry import read_records
+    for rec in read_records(open("capture.bin", "rb")):
+        if rec["type"] == "pitch":
+            print(rec["frame"], rec["bin"])
+
+Every frame sits between 0x00 delimiters. A frame whose COBS encoding, length
+or CRC-16/CCITT does not check out is counted as bad and skipped. Anything
+that was not framed (printf or TLOG text sharing the console) is returned as
+a "text" record so nothing is lost.
+
+@author  Ishmael Pelayo
+@date    2026-10-18
+"""
+
+import struct
+
+TELEM_PITCH = 1
+TELEM_PEAKS = 2
+TELEM_SPECTRUM = 3
+TELEM_COUNTERS = 4
+TELEM_CAPTURE = 5
+
+TYPE_NAMES = {TELEM_PITCH: "pitch", TELEM_PEAKS: "peaks", TELEM_SPECTRUM: "spectrum", TELEM_COUNTERS: "counters",
+              TELEM_CAPTURE: "capture"}
+
+# capture_kind_t, low nibble of the kind byte of a capture record
+CAPTURE_KIND_PITCH = 1
+CAPTURE_KIND_SAMPLES = 2
+CAPTURE_KIND_ADPCM = 3
+CAPTURE_KIND_RICE = 4
+CAPTURE_SAMPLES_PER_RECORD = 64
+CAPTURE_FRAME_KINDS = {CAPTURE_KIND_SAMPLES: "samples", CAPTURE_KIND_ADPCM: "adpcm", CAPTURE_KIND_RICE: "rice"}
+
+# source/sample_codec.c
+ADPCM_STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767]
+ADPCM_INDEX_STEP = [-1, -1, -1, -1, 2, 4, 6, 8]
+RICE_ESCAPE = 16
+
+# telem_counter_t order, unknown trailing counters are kept as counter_<n>
+COUNTER_NAMES = ["frames", "console_dropped", "telem_records", "stack_high_water"]
+
+HEADER = struct.Struct("<BBI")
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Returns the decoded bytes, or None when data is not valid COBS."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_record(payload):
+    """Decoded frame -> dict, or None if it is too short or the CRC is wrong."""
+    if len(payload) < HEADER.size + 2:
+        return None
+    body, crc = payload[:-2], struct.unpack_from("<H", payload, len(payload) - 2)[0]
+    if crc16_ccitt(body) != crc:
+        return None
+    rtype, seq, frame = HEADER.unpack_from(body)
+    data = body[HEADER.size:]
+    rec = {"type": TYPE_NAMES.get(rtype, "type_%d" % rtype), "seq": seq, "frame": frame}
+
+    try:
+        if rtype == TELEM_PITCH:
+            rec["bin"], rec["magnitude"] = struct.unpack_from("<Hh", data)
+        elif rtype == TELEM_PEAKS:
+            k = data[0]
+            pairs = struct.unpack_from("<" + "Hh" * k, data, 1)
+            rec["peaks"] = [{"bin": pairs[2 * i], "magnitude": pairs[2 * i + 1]} for i in range(k)]
+        elif rtype == TELEM_SPECTRUM:
+            n, = struct.unpack_from("<H", data)
+            rec["magnitudes"] = list(struct.unpack_from("<%dh" % n, data, 2))
+        elif rtype == TELEM_COUNTERS:
+            n = data[0]
+            values = struct.unpack_from("<%dI" % n, data, 1)
+            for i, v in enumerate(values):
+                rec[COUNTER_NAMES[i] if i < len(COUNTER_NAMES) else "counter_%d" % i] = v
+        elif rtype == TELEM_CAPTURE:
+            kind, payload = data[0] & 0x0F, data[1:]
+            if kind == CAPTURE_KIND_PITCH:
+                rec["kind"] = "pitch"
+                rec["bin"], rec["magnitude"] = struct.unpack_from("<Hh", payload)
+            elif kind == CAPTURE_KIND_SAMPLES:
+                rec["kind"] = "samples"
+                rec["chunk"] = data[0] >> 4
+                rec["first_sample"] = rec["chunk"] * CAPTURE_SAMPLES_PER_RECORD
+                rec["samples"] = list(struct.unpack_from("<%dH" % (len(payload) // 2), payload))
+            elif kind in CAPTURE_FRAME_KINDS:
+                rec["kind"] = CAPTURE_FRAME_KINDS[kind]
+                rec["chunk"] = data[0] >> 4
+                rec["data"] = payload.hex()
+            else:
+                rec["kind"] = "kind_%d" % kind
+                rec["raw"] = payload.hex()
+        else:
+            rec["raw"] = data.hex()
+    except (struct.error, IndexError):
+        return None
+    return rec
+
+
+def read_records(stream, stats=None):
+    """Yields record dicts from a binary stream. stats (a dict) collects
+    good/bad/lost counts as it goes."""
+    if stats is None:
+        stats = {}
+    for key in ("records", "bad_frames", "lost", "text_bytes"):
+        stats.setdefault(key, 0)
+    last_seq = None
+    buf = b""
+
+    while True:
+        chunk = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+        buf += chunk
+        parts = buf.split(b"\0")
+        # the last part is unterminated, keep it until the stream ends
+        buf = parts.pop() if chunk else b""
+        for part in parts:
+            if not part:
+                continue
+            payload = cobs_decode(part)
+            rec = parse_record(payload) if payload is not None else None
+            if rec is None:
+                # printable runs are console text, anything else is a damaged frame
+                if all(b >= 0x20 or b in (0x09, 0x0A, 0x0D, 0x1E) for b in part):
+                    stats["text_bytes"] += len(part)
+                    yield {"type": "text", "text": part.decode(errors="replace")}
+                else:
+                    stats["bad_frames"] += 1
+                continue
+            if last_seq is not None:
+                stats["lost"] += (rec["seq"] - last_seq - 1) & 0xFF
+            last_seq = rec["seq"]
+            stats["records"] += 1
+            yield rec
+        if not chunk:
+            break
+
+
+
+def adpcm_decode(block, n):
+    """IMA-ADPCM block from adpcm_encode() -> n unsigned samples, or None if it is short."""
+    if len(block) < 4 + n // 2 or block[2] > 88:
+        return None
+    predictor, = struct.unpack_from("<h", block)
+    index = block[2]
+    out = [predictor & 0xFFFF ^ 0x8000]
+    for i in range(n - 1):
+        code = block[4 + i // 2] >> (4 * (i & 1)) & 0x0F
+        step = ADPCM_STEPS[index]
+        vpdiff = step >> 3
+        if code & 4:
+            vpdiff += step
+        if code & 2:
+            vpdiff += step >> 1
+        if code & 1:
+            vpdiff += step >> 2
+        predictor = predictor - vpdiff if code & 8 else predictor + vpdiff
+        predictor = max(-32768, min(32767, predictor))
+        index = max(0, min(88, index + ADPCM_INDEX_STEP[code & 7]))
+        out.append(predictor & 0xFFFF ^ 0x8000)
+    return out
+
+
+def rice_decode(block, n):
+    """Delta + Rice block from rice_encode() -> n unsigned samples, or None if the stream ends early."""
+    if len(block) >= 2 * n:
+        return list(struct.unpack_from("<%dH" % n, block))
+    words = struct.unpack_from("<%dH" % (len(block) // 2), block)
+    if len(words) < 2:
+        return None
+    bits = "".join(format(w, "016b") for w in words[1:])
+
+    def take(pos, count):
+        if pos + count > len(bits):
+            raise IndexError
+        return int(bits[pos:pos + count], 2) if count else 0
+
+    k = take(0, 4)
+    pos = 4
+    prev = words[0]
+    out = [prev]
+    try:
+        for _ in range(n - 1):
+            q = 0
+            while q < RICE_ESCAPE and take(pos, 1):
+                q += 1
+                pos += 1
+            if q == RICE_ESCAPE:
+                u = take(pos, 16)
+                pos += 16
+            else:
+                u = (q << k) | take(pos + 1, k)  # past the terminating zero
+                pos += 1 + k
+            prev = (prev + ((u >> 1) ^ -(u & 1))) & 0xFFFF
+            out.append(prev)
+    except IndexError:
+        return None
+    return out
+
+
+def decode_frame(codec, block, n=512):
+    """One reassembled ADC block -> n samples, or None if it does not decode."""
+    if codec == "adpcm":
+        return adpcm_decode(block, n)
+    if codec == "rice":
+        return rice_decode(block, n)
+    return list(struct.unpack_from("<%dH" % n, block)) if len(block) >= 2 * n else None
+
+
+def read_frames(records, n=512, stats=None):
+    """Reassembles the chunked ADC blocks of a capture log dump. Yields
+    {"frame", "codec", "bytes", "samples"} per frame; stats (a dict) counts
+    the frames that had a chunk missing or did not decode."""
+    if stats is None:
+        stats = {}
+    stats.setdefault("frames", 0)
+    stats.setdefault("broken_frames", 0)
+    parts = None
+
+    def finish(parts):
+        samples = decode_frame(parts["codec"], bytes(parts["data"]), n)
+        if samples is None:
+            stats["broken_frames"] += 1
+            return None
+        stats["frames"] += 1
+        return {"frame": parts["frame"], "codec": parts["codec"], "bytes": len(parts["data"]), "samples": samples}
+
+    for rec in records:
+        if rec.get("type") != "capture" or rec.get("kind") not in CAPTURE_FRAME_KINDS.values():
+            continue
+        if rec["kind"] == "samples":
+            data = struct.pack("<%dH" % len(rec["samples"]), *rec["samples"])
+        else:
+            data = bytes.fromhex(rec["data"])
+
+        if parts is not None and parts["frame"] == rec["frame"] and parts["codec"] == rec["kind"]:
+            if rec["chunk"] == parts["next"]:
+                parts["data"] += data
+                parts["next"] += 1
+            else:
+                # an abandoned record left a hole, the frame cannot be rebuilt
+                parts["broken"] = True
+            continue
+
+        if parts is not None:
+            frame = None if parts["broken"] else finish(parts)
+            stats["broken_frames"] += parts["broken"]
+            if frame is not None:
+                yield frame
+        parts = {"frame": rec["frame"], "codec": rec["kind"], "data": bytearray(data), "next": 1,
+                 "broken": rec["chunk"] != 0}
+
+    if parts is not None:
+        frame = None if parts["broken"] else finish(parts)
+        stats["broken_frames"] += parts["broken"]
+        if frame is not None:
+            yield frame
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""
+tlog_decode.py - expand TLOG() records from a console capture
+
+TLOG() (source/tlog.h) sends TLOG_SYNC, an argument count, the flash address
+of the format string and the raw argument words instead of formatted text.
+This reads the capture (a file, or - for stdin so it can sit behind the
+serial port), looks each address up in the .axf the firmware was built from
+and prints the text printf would have printed. Plain text in the capture is
+passed through untouched, and a sync byte that does not start a record with a
+known format string and matching argument count is treated as text too.
+
+usage: tlog_decode.py Debug/ECEN5813_FinalProject.axf capture.bin
+       cat /dev/ttyACM0 | tlog_decode.py Debug/ECEN5813_FinalProject.axf -
+
+@author  Ishmael Pelayo
+@date    2026-10-18
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+TLOG_SYNC = 0x1E
+TLOG_MAX_ARGS = 6
+HEADER = 6
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 2
+
+CONVERSION = re.compile(rb"%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|z|j|t)?([diuxXocsp%])")
+
+
+class Image:
+    """Loaded sections of an ELF file, addressable by target address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            elf = f.read()
+        if elf[:4] != b"\x7fELF":
+            sys.exit("tlog_decode: %s is not an ELF file" % path)
+        is64 = elf[4] == 2
+        end = "<" if elf[5] == 1 else ">"
+
+        if is64:
+            shoff, = struct.unpack_from(end + "Q", elf, 0x28)
+            shentsize, shnum = struct.unpack_from(end + "HH", elf, 0x3A)
+        else:
+            shoff, = struct.unpack_from(end + "I", elf, 0x20)
+            shentsize, shnum = struct.unpack_from(end + "HH", elf, 0x2E)
+
+        self.sections = []
+        for i in range(shnum):
+            base = shoff + i * shentsize
+            if is64:
+                _, stype, flags, addr, off, size = struct.unpack_from(end + "IIQQQQ", elf, base)
+            else:
+                _, stype, flags, addr, off, size = struct.unpack_from(end + "IIIIII", elf, base)
+            if stype == SHT_PROGBITS and flags & SHF_ALLOC and size:
+                self.sections.append((addr, addr + size, elf[off:off + size]))
+
+    def cstring(self, addr):
+        for start, stop, data in self.sections:
+            if start <= addr < stop:
+                nul = data.find(b"\0", addr - start)
+                if nul < 0:
+                    return None
+                return data[addr - start:nul]
+        return None
+
+
+def count_args(fmt):
+    n = 0
+    for m in CONVERSION.finditer(fmt):
+        if m.group(5) == b"%":
+            continue
+        n += 1 + (m.group(2) == b"*") + (m.group(3) == b"*")
+    return n
+
+
+def expand(fmt, args, image):
+    """printf fmt with 32 bit argument words the way the device would have."""
+    out = []
+    words = iter(args)
+    pos = 0
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[pos:m.start()].decode(errors="replace"))
+        pos = m.end()
+        flags, width, prec, _, conv = (g.decode() if g else "" for g in m.groups())
+        if conv == "%":
+            out.append("%")
+            continue
+        if width == "*":
+            width = str(struct.unpack("<i", struct.pack("<I", next(words)))[0])
+        if prec == "*":
+            prec = str(next(words))
+        word = next(words)
+        spec = "%" + flags + width + ("." + prec if prec else "")
+        if conv in "di":
+            out.append((spec + "d") % struct.unpack("<i", struct.pack("<I", word))[0])
+        elif conv == "u":
+            out.append((spec + "d") % word)
+        elif conv in "xXo":
+            out.append((spec + conv) % word)
+        elif conv == "c":
+            out.append((spec + "c") % chr(word & 0xFF))
+        elif conv == "p":
+            out.append((spec + "s") % ("0x%08x" % word))
+        elif conv == "s":
+            s = image.cstring(word)
+            out.append((spec + "s") % (s.decode(errors="replace") if s is not None else "<0x%08x>" % word))
+    out.append(fmt[pos:].decode(errors="replace"))
+    return "".join(out)
+
+
+def decode(stream, image, out):
+    """Returns (records, passthrough bytes)."""
+    buf = b""
+    records = passthrough = 0
+    formats = {}
+
+    while True:
+        chunk = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+        if chunk:
+            buf += chunk
+        i = 0
+        while i < len(buf):
+            sync = buf.find(bytes([TLOG_SYNC]), i)
+            if sync < 0:
+                sync = len(buf)
+            if sync > i:
+                out.write(buf[i:sync].decode(errors="replace"))
+                passthrough += sync - i
+                i = sync
+                continue
+            nargs = buf[i + 1] if len(buf) - i > 1 else 0
+            fmt = want = None
+            if nargs <= TLOG_MAX_ARGS and len(buf) - i >= HEADER + 4 * nargs:
+                addr, = struct.unpack_from("<I", buf, i + 2)
+                if addr not in formats:
+                    fmt = image.cstring(addr)
+                    formats[addr] = (fmt, count_args(fmt)) if fmt is not None else (None, -1)
+                fmt, want = formats[addr]
+            elif nargs <= TLOG_MAX_ARGS and chunk:
+                break  # wait for the rest of the record
+            if fmt is None or want != nargs:
+                # not a record, or a damaged one: show the byte and resync after it
+                out.write(chr(TLOG_SYNC))
+                passthrough += 1
+                i += 1
+                continue
+            args = struct.unpack_from("<%dI" % nargs, buf, i + HEADER)
+            out.write(expand(fmt, args, image))
+            records += 1
+            i += HEADER + 4 * nargs
+        buf = buf[i:]
+        out.flush()
+        if not chunk:
+            break
+
+    return records, passthrough
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("axf")
+    ap.add_argument("capture", help="raw console capture, - for stdin")
+    ap.add_argument("--stats", action="store_true", help="record / text byte counts on stderr")
+    args = ap.parse_args()
+
+    image = Image(args.axf)
+    stream = sys.stdin.buffer if args.capture == "-" else open(args.capture, "rb")
+    records, passthrough = decode(stream, image, sys.stdout)
+    if args.stats:
+        sys.stderr.write("%d records, %d bytes of plain text\n" % (records, passthrough))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
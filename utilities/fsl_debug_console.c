@@ -73,6 +73,9 @@
 
 #if defined(FSL_FEATURE_SOC_LPSCI_COUNT) && (FSL_FEATURE_SOC_LPSCI_COUNT > 0)
 #include "fsl_lpsci.h"
+#if (DEBUG_CONSOLE_TX_RING_SIZE > 0U) && (DEBUG_CONSOLE_TX_DMA_CHANNEL > 0U)
+#include "fsl_lpsci_dma.h"
+#endif
 #endif /* FSL_FEATURE_SOC_LPSCI_COUNT */
 
 #if defined(FSL_FEATURE_SOC_LPUART_COUNT) && (FSL_FEATURE_SOC_LPUART_COUNT > 0)
@@ -165,6 +168,12 @@ typedef struct DebugConsoleState
     debug_console_ops_t ops; /*!< Operation function pointers for debug UART operations. */
 } debug_console_state_t;
 
+#if defined(FSL_FEATURE_SOC_LPSCI_COUNT) && (FSL_FEATURE_SOC_LPSCI_COUNT > 0) && (DEBUG_CONSOLE_TX_RING_SIZE > 0U)
+/*! @brief LPSCI output goes through the interrupt drained transmit ring. */
+#define DEBUG_CONSOLE_LPSCI_TX_RING 1U
+#define DEBUG_CONSOLE_TX_RING_MASK (DEBUG_CONSOLE_TX_RING_SIZE - 1U)
+#endif
+
 /*! @brief Type of KSDK printf function pointer. */
 typedef int (*PUTCHAR_FUNC)(int a);
 
@@ -213,6 +222,27 @@ enum _debugconsole_scanf_flag
 /*! @brief Debug UART state information. */
 static debug_console_state_t s_debugConsole = {.type = DEBUG_CONSOLE_DEVICE_TYPE_NONE, .base = NULL, .ops = {{0}, {0}}};
 
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+/*
+ * Single producer (thread mode writes) / single consumer (UART0 interrupt) ring.
+ * Indices run freely and are masked on access, head - tail is the fill level.
+ * Only the writer moves head and only the TX idle callback moves tail, so no locking is needed.
+ */
+static uint8_t s_txRing[DEBUG_CONSOLE_TX_RING_SIZE];
+static volatile uint32_t s_txHead;     /*!< Bytes ever written into the ring. */
+static volatile uint32_t s_txTail;     /*!< Bytes ever handed to the UART. */
+static volatile uint32_t s_txInFlight; /*!< Size of the chunk the LPSCI handle is sending. */
+static volatile uint32_t s_txDropped;  /*!< Bytes lost to a full ring. */
+static volatile debug_console_tx_overflow_t s_txOverflow = DEBUG_CONSOLE_TX_OVERFLOW;
+static void (*volatile s_rxNotify)(void); /*!< Receive ring callback, see DbgConsole_SetRxNotify(). */
+/*! @brief The SDK's UART0 handler in fsl_lpsci.c, UART0_IRQHandler() wraps it. */
+void UART0_DriverIRQHandler(void);
+static lpsci_handle_t s_lpsciHandle;
+#if DEBUG_CONSOLE_TX_DMA_CHANNEL
+static lpsci_dma_handle_t s_lpsciDmaHandle;
+#endif /* DEBUG_CONSOLE_TX_DMA_CHANNEL */
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -228,6 +258,167 @@ double modf(double input_dbl, double *intpart_ptr);
 
 /*************Code for DbgConsole Init, Deinit, Printf, Scanf *******************************/
 
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+/*!
+ * @brief Hands the next contiguous run of the ring to the LPSCI handle if it is idle.
+ *
+ * Called by the writer after it moves head and by the TX idle callback after it moves tail.
+ * TX completion (UART0 or DMA interrupt) only fires while a transfer is busy, so the two
+ * callers never both see it idle.
+ */
+static void DbgConsole_LpsciKick(UART0_Type *base)
+{
+    lpsci_transfer_t xfer;
+    uint32_t tail;
+    uint32_t offset;
+    uint32_t count;
+
+#if DEBUG_CONSOLE_TX_DMA_CHANNEL
+    if (LPSCI_TransferGetSendCountDMA(base, &s_lpsciDmaHandle, &count) != kStatus_NoTransferInProgress)
+#else
+    if (LPSCI_TransferGetSendCount(base, &s_lpsciHandle, &count) != kStatus_NoTransferInProgress)
+#endif /* DEBUG_CONSOLE_TX_DMA_CHANNEL */
+    {
+        return;
+    }
+
+    tail = s_txTail;
+    count = s_txHead - tail;
+    if (count == 0U)
+    {
+        return;
+    }
+
+    /* Stop at the end of the buffer, the wrapped part goes out with the next chunk. */
+    offset = tail & DEBUG_CONSOLE_TX_RING_MASK;
+    if (count > DEBUG_CONSOLE_TX_RING_SIZE - offset)
+    {
+        count = DEBUG_CONSOLE_TX_RING_SIZE - offset;
+    }
+
+    s_txInFlight = count;
+    xfer.data = &s_txRing[offset];
+    xfer.dataSize = count;
+#if DEBUG_CONSOLE_TX_DMA_CHANNEL
+    LPSCI_TransferSendDMA(base, &s_lpsciDmaHandle, &xfer);
+#else
+    LPSCI_TransferSendNonBlocking(base, &s_lpsciHandle, &xfer);
+#endif /* DEBUG_CONSOLE_TX_DMA_CHANNEL */
+}
+
+#if DEBUG_CONSOLE_TX_DMA_CHANNEL
+/*!
+ * @brief LPSCI DMA callback, runs in the DMA channel interrupt once a chunk is in the UART.
+ */
+static void DbgConsole_LpsciDmaCallback(UART0_Type *base, lpsci_dma_handle_t *handle, status_t status, void *userData)
+{
+    /* A bus error loses the rest of the chunk, move on rather than resend it forever. */
+    s_txTail += s_txInFlight;
+    s_txInFlight = 0U;
+    DbgConsole_LpsciKick(base);
+}
+#endif /* DEBUG_CONSOLE_TX_DMA_CHANNEL */
+
+/*!
+ * @brief LPSCI transactional callback, runs in UART0_IRQHandler.
+ */
+static void DbgConsole_LpsciCallback(UART0_Type *base, lpsci_handle_t *handle, status_t status, void *userData)
+{
+    if (status == kStatus_LPSCI_TxIdle)
+    {
+        s_txTail += s_txInFlight;
+        s_txInFlight = 0U;
+        DbgConsole_LpsciKick(base);
+    }
+}
+
+/*!
+ * @brief UART0 vector, replaces the weak one in the startup code.
+ *
+ * Runs the SDK handler, then reports bytes it stored in the receive ring. The SDK
+ * only calls back when a receive request completes, never per ring byte.
+ */
+void UART0_IRQHandler(void)
+{
+    uint16_t head = s_lpsciHandle.rxRingBufferHead;
+
+    UART0_DriverIRQHandler();
+    if ((s_lpsciHandle.rxRingBuffer != NULL) && (s_lpsciHandle.rxRingBufferHead != head) && (s_rxNotify != NULL))
+    {
+        s_rxNotify();
+    }
+}
+
+/*!
+ * @brief Copies up to length bytes into the ring and starts the transmitter.
+ *
+ * @return Number of bytes queued.
+ */
+static size_t DbgConsole_TxRingPut(UART0_Type *base, const uint8_t *buffer, size_t length)
+{
+    uint32_t head = s_txHead;
+    uint32_t room = DEBUG_CONSOLE_TX_RING_SIZE - (head - s_txTail);
+    size_t i;
+
+    if (length > room)
+    {
+        length = room;
+    }
+    for (i = 0U; i < length; i++)
+    {
+        s_txRing[(head + i) & DEBUG_CONSOLE_TX_RING_MASK] = buffer[i];
+    }
+
+    /* Publish the bytes only after they are in the ring. */
+    s_txHead = head + length;
+    DbgConsole_LpsciKick(base);
+
+    return length;
+}
+
+/*!
+ * @brief Non-blocking replacement for LPSCI_WriteBlocking, applies the overflow policy.
+ */
+static void DbgConsole_LpsciWriteRing(UART0_Type *base, const uint8_t *buffer, size_t length)
+{
+    size_t room = DEBUG_CONSOLE_TX_RING_SIZE - (s_txHead - s_txTail);
+    size_t queued;
+
+    switch (s_txOverflow)
+    {
+        case kDebugConsole_TxOverflowDropWrite:
+            if (length > room)
+            {
+                s_txDropped += length;
+                return;
+            }
+            DbgConsole_TxRingPut(base, buffer, length);
+            break;
+
+        case kDebugConsole_TxOverflowBlock:
+            while (length > 0U)
+            {
+                queued = DbgConsole_TxRingPut(base, buffer, length);
+                buffer += queued;
+                length -= queued;
+
+                /* With interrupts masked the ring cannot drain, drop instead of hanging. */
+                if ((length > 0U) && (__get_PRIMASK() != 0U))
+                {
+                    s_txDropped += length;
+                    break;
+                }
+            }
+            break;
+
+        default:
+            queued = DbgConsole_TxRingPut(base, buffer, length);
+            s_txDropped += length - queued;
+            break;
+    }
+}
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
+
 /* See fsl_debug_console.h for documentation of this function. */
 status_t DbgConsole_Init(uint32_t baseAddr, uint32_t baudRate, uint8_t device, uint32_t clkSrcFreq)
 {
@@ -273,7 +464,23 @@ status_t DbgConsole_Init(uint32_t baseAddr, uint32_t baudRate, uint8_t device, u
             LPSCI_EnableTx(s_debugConsole.base, true);
             LPSCI_EnableRx(s_debugConsole.base, true);
             /* Set the function pointer for send and receive for this kind of device. */
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+            s_txHead = 0U;
+            s_txTail = 0U;
+            s_txInFlight = 0U;
+            s_txDropped = 0U;
+            s_txOverflow = DEBUG_CONSOLE_TX_OVERFLOW;
+            /* The transactional handle serves UART0_IRQHandler, its TX idle callback drains the ring. */
+            LPSCI_TransferCreateHandle(s_debugConsole.base, &s_lpsciHandle, DbgConsole_LpsciCallback, NULL);
+#if DEBUG_CONSOLE_TX_DMA_CHANNEL
+            /* Whole runs of the ring go out by DMA, one interrupt per run instead of per byte. */
+            LPSCI_TransferTxCreateHandleDMA(s_debugConsole.base, &s_lpsciDmaHandle, DbgConsole_LpsciDmaCallback, NULL,
+                                            DEBUG_CONSOLE_TX_DMA_CHANNEL);
+#endif /* DEBUG_CONSOLE_TX_DMA_CHANNEL */
+            s_debugConsole.ops.tx_union.LPSCI_PutChar = DbgConsole_LpsciWriteRing;
+#else
             s_debugConsole.ops.tx_union.LPSCI_PutChar = LPSCI_WriteBlocking;
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
             s_debugConsole.ops.rx_union.LPSCI_GetChar = LPSCI_ReadBlocking;
         }
         break;
@@ -351,6 +558,12 @@ status_t DbgConsole_Deinit(void)
 #if defined(FSL_FEATURE_SOC_LPSCI_COUNT) && (FSL_FEATURE_SOC_LPSCI_COUNT > 0)
         case DEBUG_CONSOLE_DEVICE_TYPE_LPSCI:
             /* Disable LPSCI module. */
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+#if DEBUG_CONSOLE_TX_DMA_CHANNEL
+            LPSCI_TransferAbortSendDMA(s_debugConsole.base, &s_lpsciDmaHandle);
+#endif /* DEBUG_CONSOLE_TX_DMA_CHANNEL */
+            LPSCI_TransferAbortSend(s_debugConsole.base, &s_lpsciHandle);
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
             LPSCI_Deinit(s_debugConsole.base);
             break;
 #endif /* FSL_FEATURE_SOC_LPSCI_COUNT */
@@ -388,6 +601,107 @@ status_t DbgConsole_Deinit(void)
     return kStatus_Success;
 }
 
+/* See fsl_debug_console.h for documentation of this function. */
+status_t DbgConsole_Write(const uint8_t *buffer, size_t length)
+{
+    /* Do nothing if the debug UART is not initialized. */
+    if (s_debugConsole.type == DEBUG_CONSOLE_DEVICE_TYPE_NONE)
+    {
+        return kStatus_Fail;
+    }
+    s_debugConsole.ops.tx_union.PutChar(s_debugConsole.base, buffer, length);
+
+    return kStatus_Success;
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+status_t DbgConsole_StartRxRingBuffer(uint8_t *ringBuffer, size_t ringBufferSize)
+{
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+    if (s_debugConsole.type == DEBUG_CONSOLE_DEVICE_TYPE_LPSCI)
+    {
+        LPSCI_TransferStartRingBuffer(s_debugConsole.base, &s_lpsciHandle, ringBuffer, ringBufferSize);
+        return kStatus_Success;
+    }
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
+    return kStatus_Fail;
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+void DbgConsole_SetRxNotify(void (*notify)(void))
+{
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+    s_rxNotify = notify;
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+int DbgConsole_TryGetchar(void)
+{
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+    lpsci_handle_t *handle = &s_lpsciHandle;
+    uint16_t tail;
+    int ch;
+
+    if ((handle->rxRingBuffer == NULL) || (handle->rxRingBufferHead == handle->rxRingBufferTail))
+    {
+        return -1;
+    }
+
+    /* The interrupt moves tail itself when the ring overruns, keep it out while we do. */
+    LPSCI_DisableInterrupts(s_debugConsole.base, kLPSCI_RxDataRegFullInterruptEnable);
+    tail = handle->rxRingBufferTail;
+    ch = handle->rxRingBuffer[tail];
+    handle->rxRingBufferTail = ((tail + 1U) == handle->rxRingBufferSize) ? 0U : (tail + 1U);
+    LPSCI_EnableInterrupts(s_debugConsole.base, kLPSCI_RxDataRegFullInterruptEnable);
+
+    return ch;
+#else
+    return -1;
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+void DbgConsole_SetTxOverflowPolicy(debug_console_tx_overflow_t policy)
+{
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+    s_txOverflow = policy;
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+uint32_t DbgConsole_GetTxDroppedCount(void)
+{
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+    return s_txDropped;
+#else
+    return 0U;
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
+}
+
+/* See fsl_debug_console.h for documentation of this function. */
+status_t DbgConsole_Flush(void)
+{
+#if DEBUG_CONSOLE_LPSCI_TX_RING
+    if (s_debugConsole.type != DEBUG_CONSOLE_DEVICE_TYPE_LPSCI)
+    {
+        return kStatus_Success;
+    }
+    while (s_txHead != s_txTail)
+    {
+        if (__get_PRIMASK() != 0U)
+        {
+            return kStatus_Fail;
+        }
+    }
+    /* Let the last character leave the shift register. */
+    while (!(LPSCI_GetStatusFlags(s_debugConsole.base) & kLPSCI_TransmissionCompleteFlag))
+    {
+    }
+#endif /* DEBUG_CONSOLE_LPSCI_TX_RING */
+    return kStatus_Success;
+}
+
 #if SDK_DEBUGCONSOLE
 /* See fsl_debug_console.h for documentation of this function. */
 int DbgConsole_Printf(const char *fmt_s, ...)
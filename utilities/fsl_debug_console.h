@@ -84,6 +84,42 @@
 #define SCANF_ADVANCED_ENABLE 0U
 #endif /* SCANF_ADVANCED_ENABLE */
 
+/*!
+ * @brief Size in bytes of the LPSCI transmit ring, a power of two.
+ *
+ * With a ring, writes only copy into RAM and the UART0 interrupt drains it, so console output
+ * never waits on the wire. Set to 0 to get the blocking LPSCI_WriteBlocking() path back.
+ */
+#ifndef DEBUG_CONSOLE_TX_RING_SIZE
+#define DEBUG_CONSOLE_TX_RING_SIZE 512U
+#endif /* DEBUG_CONSOLE_TX_RING_SIZE */
+
+#if (DEBUG_CONSOLE_TX_RING_SIZE & (DEBUG_CONSOLE_TX_RING_SIZE - 1U))
+#error "DEBUG_CONSOLE_TX_RING_SIZE must be a power of two"
+#endif
+
+/*!
+ * @brief DMA channel that drains the LPSCI transmit ring, one transfer per contiguous run.
+ *
+ * Set to 0 to drain it from the UART0 interrupt one byte at a time instead. Channel 0 is the ADC's.
+ */
+#ifndef DEBUG_CONSOLE_TX_DMA_CHANNEL
+#define DEBUG_CONSOLE_TX_DMA_CHANNEL 1U
+#endif /* DEBUG_CONSOLE_TX_DMA_CHANNEL */
+
+/*! @brief What a write does when it does not fit in the transmit ring. */
+typedef enum _debug_console_tx_overflow
+{
+    kDebugConsole_TxOverflowDrop = 0U, /*!< Keep what fits, drop the rest of the write. */
+    kDebugConsole_TxOverflowDropWrite, /*!< Drop the whole write so lines are never cut. */
+    kDebugConsole_TxOverflowBlock,     /*!< Wait for the interrupt to make room (not from ISRs). */
+} debug_console_tx_overflow_t;
+
+/*! @brief Overflow policy after DbgConsole_Init(), see DbgConsole_SetTxOverflowPolicy(). */
+#ifndef DEBUG_CONSOLE_TX_OVERFLOW
+#define DEBUG_CONSOLE_TX_OVERFLOW kDebugConsole_TxOverflowDrop
+#endif /* DEBUG_CONSOLE_TX_OVERFLOW */
+
 #if SDK_DEBUGCONSOLE /* Select printf, scanf, putchar, getchar of SDK version. */
 #define PRINTF DbgConsole_Printf
 #define SCANF DbgConsole_Scanf
@@ -140,6 +176,73 @@ status_t DbgConsole_Init(uint32_t baseAddr, uint32_t baudRate, uint8_t device, u
  */
 status_t DbgConsole_Deinit(void);
 
+/*!
+ * @brief Writes raw bytes to the debug console without any formatting.
+ *
+ * Takes the same path as printf (the transmit ring on LPSCI), for binary log records.
+ *
+ * @param buffer Bytes to send.
+ * @param length Number of bytes.
+ * @retval kStatus_Success  Bytes were handed over, the overflow policy may still drop some.
+ * @retval kStatus_Fail     The debug console is not initialized.
+ */
+status_t DbgConsole_Write(const uint8_t *buffer, size_t length);
+
+/*!
+ * @brief Starts interrupt driven reception into a ring buffer (LPSCI_TransferStartRingBuffer).
+ *
+ * After this the UART0 interrupt stores every received byte and DbgConsole_TryGetchar() reads
+ * them without waiting. The blocking getchar/scanf path must not be used at the same time.
+ *
+ * @param ringBuffer Storage for received bytes.
+ * @param ringBufferSize Size of ringBuffer, one byte of it is kept free.
+ * @retval kStatus_Success  Reception started.
+ * @retval kStatus_Fail     The console is not an LPSCI with a transmit ring.
+ */
+status_t DbgConsole_StartRxRingBuffer(uint8_t *ringBuffer, size_t ringBufferSize);
+
+/*!
+ * @brief Sets a function the UART0 interrupt calls after it stores received bytes in the ring.
+ *
+ * It runs in interrupt context, e.g. to post an event to the scheduler. NULL turns it off.
+ *
+ * @param notify Called once per UART0 interrupt that stored bytes in the ring.
+ */
+void DbgConsole_SetRxNotify(void (*notify)(void));
+
+/*!
+ * @brief Takes one byte from the receive ring without waiting.
+ *
+ * @return The byte, or -1 if nothing has arrived.
+ */
+int DbgConsole_TryGetchar(void);
+
+/*!
+ * @brief Selects what happens when a write does not fit in the transmit ring.
+ *
+ * The ring has a single producer: write from thread mode only, never from an ISR.
+ *
+ * @param policy One of debug_console_tx_overflow_t.
+ */
+void DbgConsole_SetTxOverflowPolicy(debug_console_tx_overflow_t policy);
+
+/*!
+ * @brief Returns the number of bytes dropped because the transmit ring was full.
+ *
+ * @return Dropped byte count since DbgConsole_Init().
+ */
+uint32_t DbgConsole_GetTxDroppedCount(void);
+
+/*!
+ * @brief Waits until everything queued in the transmit ring has been handed to the UART.
+ *
+ * Use before entering a low power mode or resetting. It blocks, so keep it out of the DSP loop.
+ *
+ * @retval kStatus_Success  Ring is empty.
+ * @retval kStatus_Fail     Interrupts are masked, the ring cannot drain.
+ */
+status_t DbgConsole_Flush(void);
+
 #if SDK_DEBUGCONSOLE
 /*!
  * @brief Writes formatted output to the standard output stream.